@@ -0,0 +1,35 @@
+/*
+ * Name: Lau Su Hui (Abby)
+ * Matric No.: MEC245045
+ * Semester: 20252026-1
+ * Course: MECS1023 ADSA
+ * Group & Theme: Group 1-Pharmacy Inventory Control System
+ * Assignment Title: Medicine Management System (Solution 3-B+ Tree)
+ */
+
+#include "alloc_counter_main.h"
+#include "avl_engine.h" // Baseline of the SIMD search experiment
+#include "benchmark_cli.h"
+#include "bplus_engine.h"
+#include "medicine_experiments.h"
+#include "medicine_menu.h"
+
+typedef MedicineManager<BPlusEngine> Manager;
+
+int main(int argc, char *argv[]) {
+  // Benchmark mode: --bench [options] runs without the menu
+  if (isBenchCommand(argc, argv))
+    return runBenchmarkCli<Manager>(argc, argv);
+
+  Manager system;
+
+  // Experiments offered by option 5 of the menu
+  static const ExperimentOption<Manager> experiments[] = {
+      {"Standard Report (Insert/Search)", &Manager::runExperiment},
+      {"SIMD Node Search vs Scalar Loop vs AVL String Keys",
+       &Manager::runSimdSearchExperiment<AVLEngine>},
+  };
+
+  runMainMenu(system, "Batch added successfully!✅", experiments);
+  return 0;
+}
@@ -0,0 +1,262 @@
+/*
+ * Name: Lau Su Hui (Abby)
+ * Matric No.: MEC245045
+ * Semester: 20252026-1
+ * Course: MECS1023 ADSA
+ * Group & Theme: Group 1-Pharmacy Inventory Control System
+ * Assignment Title: Medicine Management System (Concurrent Benchmark)
+ */
+
+#include <atomic>
+#include <ctime> // For seeding random generator
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+#include "alloc_counter_main.h"
+#include "avl_engine.h"
+#include "concurrent_manager.h"
+#include "medicine_menu.h"
+#include "persistent_avl_engine.h"
+
+typedef ConcurrentMedicineManager<AVLEngine> SharedSystem;
+
+// Per-thread random numbers (xorshift64)
+// rand() shares one locked state between threads, which would serialise
+// the very counters being measured
+struct FastRandom {
+  uint64_t state;
+  explicit FastRandom(uint64_t seed) : state(seed * 0x9E3779B97F4A7C15ULL) {}
+  uint64_t next() {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+  }
+};
+
+// Thread counts to measure: 1, 2, 4, ... and finally every core
+vector<int> threadCounts() {
+  int cores = (int)thread::hardware_concurrency();
+  if (cores < 1)
+    cores = 1;
+  vector<int> counts;
+  for (int t = 1; t < cores; t *= 2) {
+    counts.push_back(t);
+  }
+  counts.push_back(cores);
+  return counts;
+}
+
+// Runs 'totalOps' random counter operations split over 'threads' threads
+// and returns the throughput in million operations per second
+// readPercent of the operations are lookups; the rest are adds and
+// deletes in equal parts, so the stock level stays roughly the same
+double runMix(SharedSystem &system, const vector<string> &ids, int threads,
+              int readPercent, size_t totalOps) {
+  atomic<bool> go(false);
+  atomic<size_t> found(0);
+  vector<thread> workers;
+  size_t opsPerThread = totalOps / threads;
+
+  for (int t = 0; t < threads; t++) {
+    workers.emplace_back([&, t]() {
+      FastRandom rng(t + 1);
+      Medicine med{"", "Counter Stock", 10, "01-JAN-2027", "Shelf"};
+      Medicine out;
+      size_t hits = 0;
+      while (!go.load(memory_order_acquire)) {
+        this_thread::yield(); // Wait for the starting signal
+      }
+      for (size_t i = 0; i < opsPerThread; i++) {
+        const string &id = ids[rng.next() % ids.size()];
+        int roll = (int)(rng.next() % 100);
+        if (roll < readPercent) {
+          hits += system.findMedicine(id, out);
+        } else if (roll % 2 == 0) {
+          med.batchID = id;
+          system.addMedicine(med);
+        } else {
+          system.removeMedicine(id);
+        }
+      }
+      found += hits; // Keeps the lookups from being optimised away
+    });
+  }
+
+  auto start = high_resolution_clock::now();
+  go.store(true, memory_order_release);
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  auto stop = high_resolution_clock::now();
+
+  double seconds = duration_cast<microseconds>(stop - start).count() / 1e6;
+  return seconds > 0 ? (opsPerThread * threads) / seconds / 1e6 : 0;
+}
+
+// Counts what one writer and 'readers' listing threads get done in about
+// 'seconds': update(rng) is one add or delete, list() one full listing
+// Every thread watches the clock itself, so a writer that is locked out
+// by the listings still finishes once they stop
+template <class Update, class List>
+pair<double, double> runUpdatesDuringListings(int readers, double seconds,
+                                              Update update, List list) {
+  auto start = high_resolution_clock::now();
+  auto deadline = start + microseconds((long long)(seconds * 1e6));
+  atomic<size_t> listings(0);
+  vector<thread> workers;
+  for (int r = 0; r < readers; r++) {
+    workers.emplace_back([&]() {
+      while (high_resolution_clock::now() < deadline) {
+        list();
+        listings++;
+      }
+    });
+  }
+
+  FastRandom rng(99);
+  size_t updates = 0;
+  while (high_resolution_clock::now() < deadline) {
+    for (int k = 0; k < 64; k++) {
+      update(rng);
+    }
+    updates += 64;
+  }
+  auto stopWriter = high_resolution_clock::now();
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  auto stop = high_resolution_clock::now();
+
+  double writerSec =
+      duration_cast<microseconds>(stopWriter - start).count() / 1e6;
+  double totalSec = duration_cast<microseconds>(stop - start).count() / 1e6;
+  return {updates / writerSec, listings / totalSec};
+}
+
+// ==========================================
+// 4. MAIN PROGRAM (CONCURRENT BENCHMARK)
+// ==========================================
+
+// Throughput of the sharded AVL manager from one thread up to every core,
+// for read-heavy, mostly-read and write-heavy counter traffic, and how
+// much stock updating full listings block (locks vs persistent snapshots)
+int main() {
+  srand(time(0)); // Seed random generator
+
+  cout << "\n=== Medicine Management System (Concurrent Benchmark) ===" << endl;
+  cout << "Enter dataset size N (e.g. 1000, 5000, 10000): ";
+  int n = getValidInt();
+  if (n < 1) {
+    cout << "Invalid number.❌" << endl;
+    return 1;
+  }
+
+  // 1. One dataset; lookups and writes draw from B0 ... B(2n - 1)
+  cout << "\nCreating " << n << " random medicines..." << endl;
+  vector<Medicine> dataset = generateDataset(n);
+  vector<string> ids;
+  for (int i = 0; i < n * 2; i++) {
+    ids.push_back("B" + to_string(i));
+  }
+
+  // 2. One shard (a single reader-writer lock) vs many shards
+  const int mixes[] = {100, 95, 50}; // % lookups
+  const size_t shardCounts[] = {1, 64};
+  vector<int> counts = threadCounts();
+  size_t totalOps = (n < 100000) ? 100000 : (size_t)n;
+
+  ofstream outFile("concurrent_results.txt");
+  cout << "\n--- Concurrent Counters (AVL Shards, " << totalOps
+       << " operations per run) ---" << endl;
+  cout << left << setw(16) << "Reads / Writes" << setw(8) << "Shards";
+  for (int t : counts) {
+    cout << setw(12) << (to_string(t) + " thr");
+  }
+  cout << "(Mops/s)" << endl;
+  cout << string(24 + 12 * counts.size() + 8, '-') << endl;
+
+  for (int readPercent : mixes) {
+    for (size_t shardCount : shardCounts) {
+      string mix =
+          to_string(readPercent) + " / " + to_string(100 - readPercent);
+      cout << left << setw(16) << mix << setw(8) << shardCount;
+      for (int t : counts) {
+        // Same starting stock for every run
+        SharedSystem system(shardCount);
+        for (const auto &med : dataset) {
+          system.addMedicine(med);
+        }
+        double mops = runMix(system, ids, t, readPercent, totalOps);
+        cout << setw(12) << mops << flush;
+        outFile << "Mix " << mix << ", " << shardCount << " shards, " << t
+                << " threads (Mops/s): " << mops << endl;
+      }
+      cout << endl;
+    }
+  }
+
+  // 3. Stock updates while full listings run: a reader-writer lock makes
+  // the writer wait for every listing; the persistent AVL does not
+  const int readerCounts[] = {0, 1, 3};
+  cout << "\n--- Stock Updates During Full Listings (1 writer, 1 s each) ---"
+       << endl;
+  cout << left << setw(26) << "Engine" << setw(10) << "Readers" << setw(16)
+       << "Updates / s" << "Listings / s" << endl;
+  cout << string(64, '-') << endl;
+  for (int readers : readerCounts) {
+    SharedSystem locked(1);
+    for (const auto &med : dataset) {
+      locked.addMedicine(med);
+    }
+    Medicine med{"", "Counter Stock", 10, "01-JAN-2027", "Shelf"};
+    pair<double, double> r = runUpdatesDuringListings(
+        readers, 1.0,
+        [&](FastRandom &rng) {
+          const string &id = ids[rng.next() % ids.size()];
+          if (rng.next() % 2 == 0) {
+            med.batchID = id;
+            locked.addMedicine(med);
+          } else {
+            locked.removeMedicine(id);
+          }
+        },
+        [&]() {
+          size_t count = 0;
+          locked.forEachMedicine([&count](const Medicine &) { count++; });
+        });
+    cout << left << setw(26) << "AVL + RW Lock" << setw(10) << readers
+         << setw(16) << r.first << r.second << endl;
+    outFile << "AVL + RW Lock, " << readers << " readers (Updates/s): "
+            << r.first << ", (Listings/s): " << r.second << endl;
+
+    MedicineManager<PersistentAVLEngine> persistent;
+    for (const auto &m : dataset) {
+      persistent.addMedicine(m, false);
+    }
+    r = runUpdatesDuringListings(
+        readers, 1.0,
+        [&](FastRandom &rng) {
+          const string &id = ids[rng.next() % ids.size()];
+          if (rng.next() % 2 == 0) {
+            med.batchID = id;
+            persistent.addMedicine(med, false);
+          } else {
+            persistent.removeMedicine(id);
+          }
+        },
+        [&]() {
+          size_t count = 0;
+          auto view = persistent.snapshot(); // Lock-free, consistent
+          view.forEach([&count](const Medicine &) { count++; });
+        });
+    cout << left << setw(26) << "Persistent AVL (Snapshot)" << setw(10)
+         << readers << setw(16) << r.first << r.second << endl;
+    outFile << "Persistent AVL, " << readers << " readers (Updates/s): "
+            << r.first << ", (Listings/s): " << r.second << endl;
+  }
+  outFile.close();
+  return 0;
+}
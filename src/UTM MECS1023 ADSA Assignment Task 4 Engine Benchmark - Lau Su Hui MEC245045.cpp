@@ -0,0 +1,159 @@
+/*
+ * Name: Lau Su Hui (Abby)
+ * Matric No.: MEC245045
+ * Semester: 20252026-1
+ * Course: MECS1023 ADSA
+ * Group & Theme: Group 1-Pharmacy Inventory Control System
+ * Assignment Title: Medicine Management System (Engine Benchmark)
+ */
+
+#include <ctime> // For seeding random generator
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random> // For mt19937_64 (the mixed workload streams)
+
+#include "alloc_counter_main.h"
+#include "avl_engine.h"
+#include "bplus_engine.h"
+#include "bst_engine.h"
+#include "medicine_experiments.h"
+#include "medicine_menu.h"
+#include "mixed_workload.h"
+#include "persistent_avl_engine.h"
+#include "rb_engine.h"
+#include "splay_engine.h"
+#include "std_map_engines.h"
+#include "treap_engine.h"
+
+// Runs the shared workload on one engine and adds a row to both tables
+// HASH_INDEX adds the exact-lookup hash index (stable-record engines only)
+template <class Engine, bool HASH_INDEX = false>
+void benchmarkEngine(const vector<Medicine> &dataset,
+                     const vector<string> &queries,
+                     const vector<string> &hotQueries, ofstream &outFile) {
+  MedicineManager<Engine> system;
+  string name = Engine::NAME;
+  if constexpr (HASH_INDEX) {
+    system.setHashIndexEnabled(true);
+    name += " + Hash";
+  }
+  WorkloadResult r = system.runWorkload(dataset, queries, hotQueries);
+
+  cout << left << setw(20) << name << setw(14) << r.insertNs << setw(14)
+       << r.searchNs << setw(14) << r.hotSearchNs << setw(16) << r.traverseMs
+       << setw(14) << r.deleteNs << r.stored << " / " << r.hits << endl;
+  outFile << name << " Avg Insert Time (ns): " << r.insertNs << endl;
+  outFile << name << " Avg Search Time (ns): " << r.searchNs << endl;
+  outFile << name << " Avg Zipf Search Time (ns): " << r.hotSearchNs << endl;
+  outFile << name << " Traversal Time (ms): " << r.traverseMs << endl;
+  outFile << name << " Avg Delete Time (ns): " << r.deleteNs << endl;
+}
+
+// Runs one operation mix on one engine; returns its label and ops/sec
+template <class Engine, bool HASH_INDEX = false>
+pair<string, double> mixThroughput(const MixedWorkload &workload) {
+  MedicineManager<Engine> system;
+  string name = Engine::NAME;
+  if constexpr (HASH_INDEX) {
+    system.setHashIndexEnabled(true);
+    name += " + Hash";
+  }
+  return {name, system.runMixedWorkload(workload).opsPerSec};
+}
+
+// ==========================================
+// 4. MAIN PROGRAM (ENGINE BENCHMARK)
+// ==========================================
+
+// Gives every storage engine the identical dataset and query list, so the
+// numbers differ only by data structure
+int main() {
+  srand(time(0)); // Seed random generator
+
+  cout << "\n=== Medicine Management System (Engine Benchmark) ===" << endl;
+  cout << "Enter dataset size N (e.g. 1000, 5000, 10000): ";
+  int n = getValidInt();
+  if (n < 1) {
+    cout << "Invalid number.❌" << endl;
+    return 1;
+  }
+
+  // 1. One dataset and one query list (hits and misses) for all engines
+  cout << "\nCreating " << n << " random medicines..." << endl;
+  vector<Medicine> dataset = generateDataset(n);
+  vector<string> queries;
+  for (int i = 0; i < n; i++) {
+    queries.push_back("B" + to_string(rand() % (n * 2)));
+  }
+  // Hot-batch lookups: a few fast movers get most requests (Zipf, 0.99)
+  vector<string> hotQueries = generateZipfQueries(dataset, n, 0.99);
+
+  // 2. The same workload on every engine
+  ofstream outFile("engine_results.txt");
+  cout << "\n--- Engine Benchmark (Size: " << n << ") ---" << endl;
+  cout << left << setw(20) << "Engine" << setw(14) << "Insert (ns)"
+       << setw(14) << "Search (ns)" << setw(14) << "Zipf (ns)" << setw(16)
+       << "Traverse (ms)" << setw(14) << "Delete (ns)" << "Stored / Found"
+       << endl;
+  cout << string(106, '-') << endl;
+  benchmarkEngine<BSTEngine>(dataset, queries, hotQueries, outFile);
+  benchmarkEngine<AVLEngine>(dataset, queries, hotQueries, outFile);
+  benchmarkEngine<AVLEngine, true>(dataset, queries, hotQueries, outFile);
+  benchmarkEngine<PersistentAVLEngine>(dataset, queries, hotQueries, outFile);
+  benchmarkEngine<RBEngine>(dataset, queries, hotQueries, outFile);
+  benchmarkEngine<TreapEngine>(dataset, queries, hotQueries, outFile);
+  benchmarkEngine<SplayEngine>(dataset, queries, hotQueries, outFile);
+  benchmarkEngine<BPlusEngine>(dataset, queries, hotQueries, outFile);
+  benchmarkEngine<MapEngine>(dataset, queries, hotQueries, outFile);
+  benchmarkEngine<HashMapEngine>(dataset, queries, hotQueries, outFile);
+
+  // 3. Mixed workloads: N stored batches, then N operations of each mix
+  // (one mix at a time, so only one operation stream is in memory)
+  vector<string> engines;
+  vector<vector<double>> throughput; // [engine][mix], ops/sec
+  mt19937_64 rng(rand());
+  for (const OperationMix &mix : STANDARD_MIXES) {
+    MixedWorkload workload = generateMixedWorkload(n, n, mix, rng);
+    const pair<string, double> results[] = {
+        mixThroughput<BSTEngine>(workload),
+        mixThroughput<AVLEngine>(workload),
+        mixThroughput<AVLEngine, true>(workload),
+        mixThroughput<PersistentAVLEngine>(workload),
+        mixThroughput<RBEngine>(workload),
+        mixThroughput<TreapEngine>(workload),
+        mixThroughput<SplayEngine>(workload),
+        mixThroughput<BPlusEngine>(workload),
+        mixThroughput<MapEngine>(workload),
+        mixThroughput<HashMapEngine>(workload)};
+    for (size_t e = 0; e < size(results); e++) {
+      if (e == engines.size()) {
+        engines.push_back(results[e].first);
+        throughput.emplace_back();
+      }
+      throughput[e].push_back(results[e].second);
+      outFile << results[e].first << " " << mix.label
+              << " Throughput (ops/sec): " << results[e].second << endl;
+    }
+  }
+
+  cout << "\n--- Mixed Workloads (" << n << " stored, " << n
+       << " operations per mix, thousand ops/sec) ---" << endl;
+  cout << left << setw(20) << "Engine";
+  for (const OperationMix &mix : STANDARD_MIXES) {
+    cout << setw(14) << mix.label;
+  }
+  cout << endl;
+  cout << string(90, '-') << endl;
+  for (size_t e = 0; e < engines.size(); e++) {
+    cout << left << setw(20) << engines[e];
+    for (double opsPerSec : throughput[e]) {
+      cout << setw(14) << (long long)(opsPerSec / 1000);
+    }
+    cout << endl;
+  }
+  cout << "Mixes: R = read, U = update; C asks for 20% absent IDs, Delete "
+       << "Churn for 25%" << endl;
+  outFile.close();
+  return 0;
+}
@@ -0,0 +1,48 @@
+/*
+ * Name: Lau Su Hui (Abby)
+ * Matric No.: MEC245045
+ * Semester: 20252026-1
+ * Course: MECS1023 ADSA
+ * Group & Theme: Group 1-Pharmacy Inventory Control System
+ * Assignment Title: Medicine Management System (Allocation Counter)
+ */
+
+// Include this file from exactly ONE .cpp file per program (the one with
+// main): it defines the replacement operator new/delete and the counter,
+// so a second .cpp including it would break the link with duplicate
+// definitions. Every other file sees only the declaration of
+// allocationCount in medicine_common.h.
+
+#ifndef ALLOC_COUNTER_MAIN_H
+#define ALLOC_COUNTER_MAIN_H
+
+#include <cstdlib> // For malloc, free
+#include <new>     // For bad_alloc
+
+#include "medicine_common.h"
+
+// ==========================================
+// HEAP ALLOCATION COUNTER (ONE PER PROGRAM)
+// ==========================================
+
+// Every operator new in the program goes through here
+// thread_local: each thread counts its own allocations, so concurrent
+// counters never contend on (or race for) one shared variable
+thread_local size_t allocationCount = 0;
+
+void *operator new(size_t size) {
+  allocationCount++;
+  if (void *p = malloc(size)) {
+    return p;
+  }
+  throw bad_alloc();
+}
+
+// noinline: once inlined, GCC would pair the malloc'd pointer of a
+// standard operator new call with this free() and warn about a mismatch
+__attribute__((noinline)) void operator delete(void *p) noexcept { free(p); }
+__attribute__((noinline)) void operator delete(void *p, size_t) noexcept {
+  free(p);
+}
+
+#endif
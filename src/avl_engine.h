@@ -0,0 +1,485 @@
+/*
+ * Name: Lau Su Hui (Abby)
+ * Matric No.: MEC245045
+ * Semester: 20252026-1
+ * Course: MECS1023 ADSA
+ * Group & Theme: Group 1-Pharmacy Inventory Control System
+ * Assignment Title: Medicine Management System (Solution 2-AVL Engine)
+ */
+
+#ifndef AVL_ENGINE_H
+#define AVL_ENGINE_H
+
+#include "task_pool.h"
+#include "tree_nodes.h"
+
+// This structure represents a "Node" in the AVL Tree
+struct AVLNode {
+  uint64_t key;    // Encoded Batch ID (or STRING_KEY), compared first
+  Medicine data;   // The medicine details
+  AVLNode *left;   // Pointer to left child (smaller Batch ID)
+  AVLNode *right;  // Pointer to right child (larger Batch ID)
+  int height;      // AVL SPECIFIC: Tracks the height of this node
+  size_t size;     // Batches in this subtree (this node included)
+  long long units; // Sum of quantity over this subtree
+
+  // Constructor to initialise a node with data, null pointers, and height 1
+  // Note: size/units are kept up to date by the engine, so the quantity of
+  // a stored batch is only changed through the engine's updateQuantity
+  // The record is moved in, so its strings are never deep-copied
+  AVLNode(Medicine &&med, uint64_t code) : data(std::move(med)) { init(code); }
+
+  void init(uint64_t code) {
+    key = code;
+    left = nullptr;
+    right = nullptr;
+    height = 1; // New nodes are always added as leaves, so initial height is 1
+    size = 1;
+    units = data.quantity;
+  }
+};
+
+// ==========================================
+// AVL ENGINE (PLUGS INTO MedicineManager)
+// ==========================================
+
+// COUNT_WORK = true compiles in the work counters (see AVLEngine and
+// CountingAVLEngine below)
+template <bool COUNT_WORK>
+class BasicAVLEngine
+    : public LinkedTreeEngine<BasicAVLEngine<COUNT_WORK>, AVLNode> {
+private:
+  typedef LinkedTreeEngine<BasicAVLEngine, AVLNode> Base;
+  friend Base; // Calls nodesChanged()
+  using Base::createNode;
+  using Base::destroyNode;
+  using Base::root; // The root pointer of the AVL Tree
+
+  FrozenIndex<AVLNode> frozen;  // Read-optimised snapshot (freeze())
+  WorkCounter<COUNT_WORK> work; // Comparisons, visits, rotations (if on)
+
+  // Three-way comparison of a (key, Batch ID) pair against a node
+  int compareKey(uint64_t key, string_view batchID, const AVLNode *node) {
+    work.compared();
+    return compareKeys(key, batchID, node->key, node->data.batchID);
+  }
+
+  // Any node added or released drops the frozen snapshot, which no longer
+  // matches the tree
+  void nodesChanged() { frozen.clear(); }
+
+  // --- AVL HELPER FUNCTIONS (BALANCING LOGIC) ---
+  // Upper bound on the tree height: an AVL tree with n nodes is at most
+  // 1.44 * log2(n + 2) high, so 96 levels cover any 64-bit node count
+  static const int MAX_HEIGHT = 96;
+
+  // Helper to get height of a node safely (handles nullptr)
+  int getHeight(AVLNode *n) {
+    if (n == nullptr)
+      return 0;
+    return n->height;
+  }
+
+  // Helper to calculate Balance Factor (Left Height - Right Height)
+  // Logic: > 1 means Left Heavy, < -1 means Right Heavy
+  int getBalance(AVLNode *n) {
+    if (n == nullptr)
+      return 0;
+    return getHeight(n->left) - getHeight(n->right);
+  }
+
+  // Helpers to read the subtree size and unit sum safely (handle nullptr)
+  static size_t getSize(AVLNode *n) { return (n == nullptr) ? 0 : n->size; }
+  static long long getUnits(AVLNode *n) {
+    return (n == nullptr) ? 0 : n->units;
+  }
+
+  // Helper to recompute the subtree size and unit sum from the children
+  void updateCounts(AVLNode *n) {
+    n->size = getSize(n->left) + getSize(n->right) + 1;
+    n->units = getUnits(n->left) + getUnits(n->right) + n->data.quantity;
+  }
+
+  // Helper to update the height of a node based on its children
+  // (and its subtree counts, which change with the children too)
+  void updateHeight(AVLNode *n) {
+    int leftH = getHeight(n->left);
+    int rightH = getHeight(n->right);
+    // Height = Max(Left, Right) + 1
+    n->height = (leftH > rightH ? leftH : rightH) + 1;
+    updateCounts(n);
+  }
+
+  // Rotation Logic: Right Rotation (Fixes Left-Left Imbalance)
+  AVLNode *rightRotate(AVLNode *y) {
+    AVLNode *x = y->left;
+    AVLNode *T2 = x->right;
+
+    // Perform Rotation
+    x->right = y;
+    y->left = T2;
+
+    // Update Heights (Child first, then Parent)
+    updateHeight(y);
+    updateHeight(x);
+
+    return x; // New root of this subtree
+  }
+
+  // Rotation Logic: Left Rotation (Fixes Right-Right Imbalance)
+  AVLNode *leftRotate(AVLNode *x) {
+    AVLNode *y = x->right;
+    AVLNode *T2 = y->left;
+
+    // Perform Rotation
+    y->left = x;
+    x->right = T2;
+
+    // Update Heights (Child first, then Parent)
+    updateHeight(x);
+    updateHeight(y);
+
+    return y; // New root of this subtree
+  }
+
+  // Helper to restore the AVL property at one node after an insert/delete
+  // Returns the (potentially new) root of this subtree
+  AVLNode *rebalance(AVLNode *node) {
+    // 1. Update Height
+    updateHeight(node);
+
+    // 2. Get Balance Factor to check if this node became unbalanced
+    int balance = getBalance(node);
+
+    // 3. If unbalanced, perform rotations (4 Cases)
+    // The cases are decided from the child's balance, which works for both
+    // insertions and deletions
+    // Left Left Case
+    if (balance > 1 && getBalance(node->left) >= 0) {
+      work.rotated(ROTATE_LL);
+      return rightRotate(node);
+    }
+
+    // Left Right Case
+    if (balance > 1 && getBalance(node->left) < 0) {
+      work.rotated(ROTATE_LR);
+      node->left = leftRotate(node->left);
+      return rightRotate(node);
+    }
+
+    // Right Right Case
+    if (balance < -1 && getBalance(node->right) <= 0) {
+      work.rotated(ROTATE_RR);
+      return leftRotate(node);
+    }
+
+    // Right Left Case
+    if (balance < -1 && getBalance(node->right) > 0) {
+      work.rotated(ROTATE_RL);
+      node->right = rightRotate(node->right);
+      return leftRotate(node);
+    }
+
+    return node;
+  }
+
+  // Helper to point a parent (or the root) at a new child subtree
+  void replaceChild(AVLNode *parent, AVLNode *oldChild, AVLNode *newChild) {
+    if (parent == nullptr) {
+      root = newChild;
+    } else if (parent->left == oldChild) {
+      parent->left = newChild;
+    } else {
+      parent->right = newChild;
+    }
+  }
+
+  // Helper to walk back up a recorded search path, fixing heights and
+  // rotating where needed (path[0] = root ... path[depth - 1] = lowest)
+  // Once a subtree keeps its old height nothing above it rotates, so the
+  // rest of the path only has its subtree counts refreshed
+  void retrace(AVLNode **path, int depth) {
+    while (depth > 0) {
+      AVLNode *node = path[--depth];
+      int oldHeight = node->height;
+      AVLNode *top = rebalance(node);
+      if (top != node) {
+        replaceChild(depth > 0 ? path[depth - 1] : nullptr, node, top);
+      }
+      if (top->height == oldHeight)
+        break;
+    }
+    while (depth > 0) {
+      updateCounts(path[--depth]);
+    }
+  }
+
+  // Iterative helper to search for a batch by ID
+  // Time Complexity: Guaranteed O(log n) due to balancing
+  AVLNode *searchInternal(uint64_t key, string_view batchID) {
+    AVLNode *current = root;
+    while (current != nullptr) {
+      work.visited();
+      int cmp = compareKey(key, batchID, current);
+      if (cmp == 0) {
+        return current;
+      }
+      current = (cmp < 0) ? current->left : current->right;
+    }
+    return nullptr;
+  }
+
+  // Helper: Batches with an ID below (key, batchID), or up to and including
+  // it if 'inclusive', as a (count, unit sum) pair, in O(log n)
+  // Logic: Every time the descent turns right, the left subtree and the
+  // node itself all come before the target
+  pair<size_t, long long> countBefore(uint64_t key, string_view batchID,
+                                      bool inclusive) {
+    size_t count = 0;
+    long long units = 0;
+    AVLNode *current = root;
+    while (current != nullptr) {
+      int cmp = compareKey(key, batchID, current);
+      if (cmp == 0) {
+        // Found: its left subtree is smaller, and the node itself counts
+        // only when inclusive
+        count += getSize(current->left) + (inclusive ? 1 : 0);
+        units += getUnits(current->left) +
+                 (inclusive ? current->data.quantity : 0);
+        break;
+      }
+      if (cmp < 0) {
+        current = current->left;
+      } else {
+        count += getSize(current->left) + 1;
+        units += getUnits(current->left) + current->data.quantity;
+        current = current->right;
+      }
+    }
+    return {count, units};
+  }
+
+public:
+  static constexpr const char *NAME = "AVL";
+  static constexpr const char *RESULTS_FILE = "avl_results.txt";
+  static constexpr bool STABLE_RECORDS = true; // Nodes never move
+  // find() changes nothing, unless it has work counters to bump
+  static constexpr bool READ_ONLY_FIND = !COUNT_WORK;
+  typedef BasicAVLEngine<true> Counting; // Same engine, counting its work
+
+  // --- CORE OPERATIONS: INSERT, SEARCH, DELETE ---
+  // All of them are iterative: the way down is recorded in a fixed-size
+  // path array, and rebalancing walks that path back up (no recursion)
+
+  // Iterative insert AND rebalance; the record is only moved into the node
+  // Returns the stored record, or nullptr (record untouched) if the Batch ID
+  // already exists
+  Medicine *insert(uint64_t key, Medicine &med) {
+    // 1. Standard BST Insertion logic, remembering every ancestor
+    AVLNode *path[MAX_HEIGHT];
+    int depth = 0;
+    int cmp = 0;
+    AVLNode *current = root;
+    while (current != nullptr) {
+      work.visited();
+      cmp = compareKey(key, med.batchID, current);
+      if (cmp == 0)
+        return nullptr; // Duplicate Case: No duplicates allowed
+      path[depth++] = current;
+      current = (cmp < 0) ? current->left : current->right;
+    }
+
+    // 2. Hook the new leaf under the last ancestor
+    AVLNode *node = createNode(std::move(med), key);
+    if (depth == 0) {
+      root = node;
+    } else if (cmp < 0) {
+      path[depth - 1]->left = node;
+    } else {
+      path[depth - 1]->right = node;
+    }
+
+    // 3. Update heights and rotate on the way back up
+    retrace(path, depth);
+    return &node->data;
+  }
+
+  // Search; packed keys are served by the frozen snapshot while it is valid
+  Medicine *find(uint64_t key, string_view batchID) {
+    AVLNode *result = (frozen.active() && key != STRING_KEY)
+                          ? frozen.find(key)
+                          : searchInternal(key, batchID);
+    return (result != nullptr) ? &result->data : nullptr;
+  }
+
+  // Sets the quantity of a stored batch in place
+  // Logic: No node moves, so only the unit sums of the nodes on the search
+  // path change, each by the same difference (sizes and heights stay)
+  // Returns the stored record, or nullptr if the Batch ID is not stored
+  Medicine *updateQuantity(uint64_t key, string_view batchID, int quantity) {
+    AVLNode *path[MAX_HEIGHT];
+    int depth = 0;
+    AVLNode *current = root;
+    while (current != nullptr) {
+      work.visited();
+      path[depth++] = current;
+      int cmp = compareKey(key, batchID, current);
+      if (cmp == 0)
+        break;
+      current = (cmp < 0) ? current->left : current->right;
+    }
+    if (current == nullptr)
+      return nullptr;
+
+    long long change = (long long)quantity - current->data.quantity;
+    current->data.quantity = quantity;
+    for (int i = 0; i < depth; i++) {
+      path[i]->units += change;
+    }
+    return &current->data;
+  }
+
+  // Iterative delete AND rebalance
+  // Nodes are relinked, so no Medicine record is ever copied
+  bool remove(uint64_t key, string_view batchID) {
+    // 1. Standard BST Delete: find the node, remembering every ancestor
+    AVLNode *path[MAX_HEIGHT];
+    int depth = 0;
+    AVLNode *target = root;
+    while (target != nullptr) {
+      work.visited();
+      int cmp = compareKey(key, batchID, target);
+      if (cmp == 0)
+        break;
+      path[depth++] = target;
+      target = (cmp < 0) ? target->left : target->right;
+    }
+    if (target == nullptr)
+      return false;
+
+    AVLNode *parent = (depth > 0) ? path[depth - 1] : nullptr;
+    if ((target->left == nullptr) || (target->right == nullptr)) {
+      // Zero or one child: the child subtree is already balanced
+      replaceChild(parent, target,
+                   target->left ? target->left : target->right);
+    } else {
+      // Two children: relink the In-Order Successor in place of the node
+      // The successor takes over the node's height and slot in the path,
+      // and its own former ancestors are recorded below it
+      int successorSlot = depth++;
+      AVLNode *successorParent = target;
+      AVLNode *successor = target->right;
+      work.visited();
+      while (successor->left != nullptr) {
+        path[depth++] = successor;
+        successorParent = successor;
+        successor = successor->left;
+        work.visited();
+      }
+      if (successorParent == target) {
+        target->right = successor->right;
+      } else {
+        successorParent->left = successor->right;
+      }
+      successor->left = target->left;
+      successor->right = target->right;
+      successor->height = target->height;
+      path[successorSlot] = successor;
+      replaceChild(parent, target, successor);
+    }
+    destroyNode(target);
+
+    // 2. Update Height and Balance the Tree along the path
+    retrace(path, depth);
+    return true;
+  }
+
+  // forEach, clear, empty, reduce, setPoolEnabled and the ordered
+  // iterators come from LinkedTreeEngine (tree_nodes.h)
+
+  // --- OPTIONAL EXTRAS ---
+  // Number of levels from the root down to the deepest leaf
+  int height() { return getHeight(root); }
+
+  // Bulk load: merges (key, record) pairs sorted by Batch ID with the
+  // stored nodes and relinks everything into a perfectly balanced tree
+  // Duplicates are skipped (first one wins); added records are moved from
+  // With a pool, the tree is linked up by all of its threads
+  // Returns the number of batches added
+  size_t bulkLoad(vector<pair<uint64_t, Medicine *>> &incoming,
+                  TaskPool *pool = nullptr) {
+    size_t added;
+    vector<AVLNode *> merged = mergeSortedNodes(
+        root, incoming,
+        [this](uint64_t key, string_view batchID, const AVLNode *node) {
+          return compareKey(key, batchID, node);
+        },
+        [this](Medicine &&med, uint64_t key) {
+          return createNode(std::move(med), key);
+        },
+        added);
+    // Sibling subtrees differ in size by at most one, so the heights (and
+    // subtree counts) set once the children are linked are exact
+    root = linkBalanced(
+        merged, 0, merged.size(), [this](AVLNode *node) { updateHeight(node); },
+        pool);
+    return added;
+  }
+
+  // Exports the tree into the frozen snapshot (until the next add/delete)
+  void freeze() { frozen.build(root); }
+  bool isFrozen() const { return frozen.active(); }
+
+  // --- ORDER STATISTICS (SUBTREE SIZES & UNIT SUMS) ---
+  // Number of batches with a smaller Batch ID, i.e. the batch's 0-based
+  // position in ID order (or where it would go), in O(log n)
+  size_t rank(uint64_t key, string_view batchID) {
+    return countBefore(key, batchID, false).first;
+  }
+
+  // The batch at 0-based position k in ID order (nullptr if k >= size)
+  // Logic: Descend, skipping whole left subtrees by their size
+  Medicine *select(size_t k) {
+    AVLNode *current = root;
+    while (current != nullptr) {
+      size_t leftSize = getSize(current->left);
+      if (k == leftSize)
+        return &current->data;
+      if (k < leftSize) {
+        current = current->left;
+      } else {
+        k -= leftSize + 1;
+        current = current->right;
+      }
+    }
+    return nullptr;
+  }
+
+  // Total quantity of the batches with lo <= ID <= hi, in O(log n)
+  // Both ends are given as (key, Batch ID) pairs; lo > hi gives 0
+  long long rangeQuantity(uint64_t loKey, string_view lo, uint64_t hiKey,
+                          string_view hi) {
+    if (compareKeys(loKey, lo, hiKey, hi) > 0)
+      return 0;
+    return countBefore(hiKey, hi, true).second -
+           countBefore(loKey, lo, false).second;
+  }
+
+  // Number of batches stored, in O(1)
+  size_t size() { return getSize(root); }
+
+  // --- TREE SHAPE & WORK COUNTERS ---
+  // Height, average depth and nodes per depth, by walking every node
+  TreeStats treeStats() { return collectTreeStats(root); }
+
+  // Comparisons, visits and rebalancing cases since the last reset (all
+  // zero unless this is the Counting engine); lookups served by the frozen
+  // snapshot skip them
+  WorkCounts workCounts() const { return work.get(); }
+  void resetWorkCounts() { work.reset(); }
+};
+
+typedef BasicAVLEngine<false> AVLEngine;        // No counting code at all
+typedef BasicAVLEngine<true> CountingAVLEngine; // Counts its work
+
+#endif
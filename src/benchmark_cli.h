@@ -0,0 +1,201 @@
+/*
+ * Name: Lau Su Hui (Abby)
+ * Matric No.: MEC245045
+ * Semester: 20252026-1
+ * Course: MECS1023 ADSA
+ * Group & Theme: Group 1-Pharmacy Inventory Control System
+ * Assignment Title: Medicine Management System (Benchmark Command Line)
+ */
+
+#ifndef BENCHMARK_CLI_H
+#define BENCHMARK_CLI_H
+
+#include <algorithm> // For sort (median and minimum)
+#include <cmath>     // For sqrt (standard deviation)
+#include <cstdlib>   // For strtod, strtoull (option values)
+#include <cstring>   // For strcmp (option names)
+#include <iomanip>   // For table formatting (setw)
+#include <iostream>
+#include <random> // For mt19937_64 (repeatable datasets)
+#include <string>
+#include <vector>
+
+#include "medicine_common.h"
+#include "medicine_experiments.h" // For runBenchmarkRep
+
+// ==========================================
+// 5. BENCHMARK MODE (COMMAND LINE)
+// ==========================================
+
+// Usage: <program> --bench [--n 1e6] [--dist random|sorted|reverse|zipf]
+//                          [--seed S] [--reps R] [--warmup W]
+// Runs insert / search / delete over one seeded dataset R times (after W
+// unmeasured warm-up runs) and prints median, minimum and standard
+// deviation in nanoseconds per operation, without the interactive menu
+struct BenchOptions {
+  size_t n;             // Dataset size (--n, e.g. 1e6)
+  KeyDistribution dist; // Order / repetition of the Batch IDs (--dist)
+  uint64_t seed;        // Random engine seed (--seed)
+  int reps;             // Measured repetitions (--reps)
+  int warmup;           // Unmeasured repetitions first (--warmup)
+};
+
+const char *const DIST_NAMES[] = {"random", "sorted", "reverse", "zipf"};
+
+// True if the program was started in benchmark mode (first argument)
+inline bool isBenchCommand(int argc, char *argv[]) {
+  return argc > 1 && strcmp(argv[1], "--bench") == 0;
+}
+
+// Reads the options after --bench into 'options' (defaults for the rest)
+// Returns false (with the reason in 'error') on an unknown option or a
+// value out of range
+inline bool parseBenchOptions(int argc, char *argv[], BenchOptions &options,
+                              string &error) {
+  options = {100000, DIST_RANDOM, 1, 5, 1};
+  for (int i = 2; i < argc; i++) {
+    string name = argv[i];
+    if (i + 1 >= argc) {
+      error = "missing value for " + name;
+      return false;
+    }
+    const char *value = argv[++i];
+    char *end = nullptr;
+    if (name == "--n") {
+      double n = strtod(value, &end); // Accepts 1e6 as well as 1000000
+      if (*end != '\0' || !(n >= 1 && n <= 1e9) || n != floor(n)) {
+        error = "--n must be a whole number from 1 to 1e9";
+        return false;
+      }
+      options.n = (size_t)n;
+    } else if (name == "--dist") {
+      bool known = false;
+      for (int d = 0; d < 4; d++) {
+        if (strcmp(value, DIST_NAMES[d]) == 0) {
+          options.dist = (KeyDistribution)d;
+          known = true;
+        }
+      }
+      if (!known) {
+        error = "--dist must be random, sorted, reverse or zipf";
+        return false;
+      }
+    } else if (name == "--seed") {
+      options.seed = strtoull(value, &end, 10);
+      if (*end != '\0' || *value == '\0') {
+        error = "--seed must be a whole number";
+        return false;
+      }
+    } else if (name == "--reps" || name == "--warmup") {
+      long count = strtol(value, &end, 10);
+      bool reps = name == "--reps";
+      if (*end != '\0' || count < (reps ? 1 : 0) || count > 1000) {
+        error = name + (reps ? " must be from 1 to 1000"
+                             : " must be from 0 to 1000");
+        return false;
+      }
+      (reps ? options.reps : options.warmup) = (int)count;
+    } else {
+      error = "unknown option " + name;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Median, minimum and (sample) standard deviation of one phase's timings
+struct BenchStats {
+  double median;
+  double min;
+  double stddev;
+};
+
+inline BenchStats summarize(vector<double> samples) {
+  BenchStats stats = {0, 0, 0};
+  if (samples.empty())
+    return stats;
+  sort(samples.begin(), samples.end());
+  size_t mid = samples.size() / 2;
+  stats.median = (samples.size() % 2 == 1)
+                     ? samples[mid]
+                     : (samples[mid - 1] + samples[mid]) / 2;
+  stats.min = samples[0];
+  if (samples.size() > 1) {
+    double mean = 0;
+    for (double x : samples) {
+      mean += x;
+    }
+    mean /= samples.size();
+    double squares = 0;
+    for (double x : samples) {
+      squares += (x - mean) * (x - mean);
+    }
+    stats.stddev = sqrt(squares / (samples.size() - 1));
+  }
+  return stats;
+}
+
+// Entry point of benchmark mode; returns the program's exit code
+template <class Manager> int runBenchmarkCli(int argc, char *argv[]) {
+  BenchOptions options;
+  string error;
+  if (!parseBenchOptions(argc, argv, options, error)) {
+    cerr << "Error: " << error << endl;
+    cerr << "Usage: " << argv[0]
+         << " --bench [--n 1e6] [--dist random|sorted|reverse|zipf]"
+         << " [--seed S] [--reps R] [--warmup W]" << endl;
+    return 1;
+  }
+
+  // 1. One dataset for every repetition
+  mt19937_64 rng(options.seed);
+  vector<Medicine> dataset =
+      generateBenchDataset(options.n, options.dist, rng);
+
+  // 2. Warm-up runs (discarded), then the measured runs
+  Manager system;
+  vector<double> insertNs, searchNs, deleteNs;
+  vector<double> rejectedInsertNs, rejectedDeleteNs;
+  BenchmarkRun last = {0, 0, 0, 0, 0, 0, 0, 0};
+  for (int rep = 0; rep < options.warmup + options.reps; rep++) {
+    last = system.runBenchmarkRep(dataset);
+    if (rep < options.warmup)
+      continue;
+    insertNs.push_back(last.insertNs);
+    rejectedInsertNs.push_back(last.rejectedInsertNs);
+    searchNs.push_back(last.searchNs);
+    deleteNs.push_back(last.deleteNs);
+    rejectedDeleteNs.push_back(last.rejectedDeleteNs);
+  }
+
+  // 3. Print Report (counts are the same in every run)
+  cout << "--- " << system.engineName() << " Benchmark (n = " << options.n
+       << ", dist = " << DIST_NAMES[options.dist]
+       << ", seed = " << options.seed << ") ---" << endl;
+  cout << options.reps << " measured runs after " << options.warmup
+       << " warm-up runs, nanoseconds per successful operation" << endl;
+  cout << "(rejected attempts, i.e. repeated IDs, are timed on their own)"
+       << endl;
+  cout << left << setw(10) << "Phase" << setw(14) << "Median" << setw(14)
+       << "Min" << setw(14) << "Stddev" << setw(12) << "Succeeded"
+       << setw(12) << "Rejected" << "Rejected Median" << endl;
+  auto row = [&](const char *phase, const vector<double> &samples,
+                 size_t succeeded, const vector<double> &rejectedSamples) {
+    BenchStats s = summarize(samples);
+    cout << left << setw(10) << phase << setw(14) << s.median << setw(14)
+         << s.min << setw(14) << s.stddev << setw(12) << succeeded
+         << setw(12) << options.n - succeeded;
+    if (succeeded < options.n && !rejectedSamples.empty()) {
+      cout << summarize(rejectedSamples).median;
+    } else {
+      cout << "-";
+    }
+    cout << endl;
+  };
+  row("Insert", insertNs, last.added, rejectedInsertNs);
+  row("Search", searchNs, last.found, {});
+  row("Delete", deleteNs, last.removed, rejectedDeleteNs);
+  return 0;
+}
+
+#endif
@@ -0,0 +1,648 @@
+/*
+ * Name: Lau Su Hui (Abby)
+ * Matric No.: MEC245045
+ * Semester: 20252026-1
+ * Course: MECS1023 ADSA
+ * Group & Theme: Group 1-Pharmacy Inventory Control System
+ * Assignment Title: Medicine Management System (Solution 3-B+ Tree Engine)
+ */
+
+#ifndef BPLUS_ENGINE_H
+#define BPLUS_ENGINE_H
+
+#include <utility> // For move (zero-copy insertion)
+#include <vector>
+
+#include "medicine_common.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h> // For SSE4.2 / AVX2 node search kernels
+#define HAVE_X86_SIMD 1
+#endif
+
+// --- B+ TREE NODES ---
+// Every node holds up to NODE_SLOTS packed keys side by side, so one node
+// visit scans two cache lines of integers instead of chasing one pointer
+// per key. Inner nodes only route; all records live in the leaves, which
+// are chained left to right so the display walks them without a stack.
+const int NODE_SLOTS = 16;                     // Keys per node (leaf or inner)
+const int MIN_LEAF_KEYS = NODE_SLOTS / 2;      // Fewer = leaf underflow
+const int MIN_INNER_KEYS = NODE_SLOTS / 2 - 1; // Fewer = inner underflow
+
+// Common header of both node kinds
+struct BNode {
+  bool isLeaf;               // true = LeafNode, false = InnerNode
+  int count;                 // Keys in use
+  uint64_t keys[NODE_SLOTS]; // Encoded Batch IDs, ascending
+
+  // The SIMD kernels read all NODE_SLOTS keys (and mask off the unused
+  // ones), so every slot starts out initialised
+  BNode(bool leaf) {
+    isLeaf = leaf;
+    count = 0;
+    for (int i = 0; i < NODE_SLOTS; i++) {
+      keys[i] = STRING_KEY;
+    }
+  }
+};
+
+// Leaf: the records themselves, stored next to their keys
+struct LeafNode : BNode {
+  LeafNode *next;               // Next leaf in Batch ID order
+  Medicine records[NODE_SLOTS]; // records[i] is the batch of keys[i]
+
+  LeafNode() : BNode(true) { next = nullptr; }
+};
+
+// Inner node: separator i is the smallest Batch ID of children[i + 1]
+// (children[i] holds the IDs below it)
+struct InnerNode : BNode {
+  BNode *children[NODE_SLOTS + 1];
+  string ids[NODE_SLOTS]; // Separator Batch IDs, only kept for STRING_KEY
+
+  InnerNode() : BNode(false) {}
+};
+
+// --- NODE SEARCH KERNELS ---
+// Each one returns how many of a node's first 'count' keys are smaller than
+// 'key'; the keys are sorted, so that is also the index of the first key
+// not smaller than it. The SIMD versions compare all NODE_SLOTS keys at
+// once, turn the results into a bit mask (movemask) and count its bits.
+typedef int (*NodeSearchKernel)(const uint64_t *keys, int count, uint64_t key);
+
+// Portable fallback: one compare per key
+inline int countLessScalar(const uint64_t *keys, int count, uint64_t key) {
+  int i = 0;
+  while (i < count && keys[i] < key) {
+    i++;
+  }
+  return i;
+}
+
+#ifdef HAVE_X86_SIMD
+// x86 only has signed 64-bit compares; flipping the top bit of both sides
+// maps unsigned key order onto signed order
+inline __attribute__((target("sse4.2"))) int
+countLessSSE42(const uint64_t *keys, int count, uint64_t key) {
+  const __m128i flip = _mm_set1_epi64x(INT64_MIN);
+  const __m128i target = _mm_xor_si128(_mm_set1_epi64x((long long)key), flip);
+  unsigned mask = 0;
+  for (int i = 0; i < NODE_SLOTS; i += 2) {
+    __m128i k = _mm_xor_si128(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(keys + i)), flip);
+    __m128i less = _mm_cmpgt_epi64(target, k); // 2 keys per compare
+    mask |= (unsigned)_mm_movemask_pd(_mm_castsi128_pd(less)) << i;
+  }
+  return __builtin_popcount(mask & ((1u << count) - 1));
+}
+
+inline __attribute__((target("avx2"))) int
+countLessAVX2(const uint64_t *keys, int count, uint64_t key) {
+  const __m256i flip = _mm256_set1_epi64x(INT64_MIN);
+  const __m256i target =
+      _mm256_xor_si256(_mm256_set1_epi64x((long long)key), flip);
+  unsigned mask = 0;
+  for (int i = 0; i < NODE_SLOTS; i += 4) {
+    __m256i k = _mm256_xor_si256(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(keys + i)), flip);
+    __m256i less = _mm256_cmpgt_epi64(target, k); // 4 keys per compare
+    mask |= (unsigned)_mm256_movemask_pd(_mm256_castsi256_pd(less)) << i;
+  }
+  return __builtin_popcount(mask & ((1u << count) - 1));
+}
+#endif
+
+// Picks the widest kernel the running CPU supports (CPUID feature check)
+inline NodeSearchKernel bestNodeSearch(const char **name) {
+#ifdef HAVE_X86_SIMD
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    *name = "AVX2";
+    return countLessAVX2;
+  }
+  if (__builtin_cpu_supports("sse4.2")) {
+    *name = "SSE4.2";
+    return countLessSSE42;
+  }
+#endif
+  *name = "Scalar";
+  return countLessScalar;
+}
+
+// ==========================================
+// B+ TREE ENGINE (PLUGS INTO MedicineManager)
+// ==========================================
+
+class BPlusEngine {
+private:
+  BNode *root; // The root node of the B+ Tree (nullptr = empty)
+  NodeSearchKernel countLess; // Node search kernel in use
+  const char *kernelName;     // Its name, for the reports
+
+  // Deepest possible path: every inner node below the root has at least
+  // MIN_INNER_KEYS + 1 = 8 children, so 24 levels cover any 64-bit size
+  static const int MAX_DEPTH = 24;
+
+  // Three-way comparison against record i of a leaf
+  static int compareRecord(uint64_t key, string_view batchID,
+                           const LeafNode *leaf, int i) {
+    return compareKeys(key, batchID, leaf->keys[i],
+                       leaf->records[i].batchID);
+  }
+
+  // Three-way comparison against separator i of an inner node
+  static int compareSeparator(uint64_t key, string_view batchID,
+                              const InnerNode *node, int i) {
+    return compareKeys(key, batchID, node->keys[i], node->ids[i]);
+  }
+
+  // Stores separator i; the Batch ID text is only needed for STRING_KEY
+  static void setSeparator(InnerNode *node, int i, uint64_t key,
+                           const string &batchID) {
+    node->keys[i] = key;
+    if (key == STRING_KEY) {
+      node->ids[i] = batchID;
+    } else {
+      node->ids[i].clear();
+    }
+  }
+
+  // --- NODE SEARCH ---
+  // Both scans first skip the smaller packed keys with the node search
+  // kernel, which touches nothing but the node's key array; only equal
+  // STRING_KEYs are then compared one by one
+
+  // Index of the child whose range contains the Batch ID
+  int childIndex(const InnerNode *node, uint64_t key, string_view batchID) {
+    int i = countLess(node->keys, node->count, key);
+    while (i < node->count && compareSeparator(key, batchID, node, i) >= 0) {
+      i++;
+    }
+    return i;
+  }
+
+  // Position of the first record not smaller than the Batch ID
+  int leafPosition(const LeafNode *leaf, uint64_t key, string_view batchID) {
+    int i = countLess(leaf->keys, leaf->count, key);
+    while (i < leaf->count && compareRecord(key, batchID, leaf, i) > 0) {
+      i++;
+    }
+    return i;
+  }
+
+  // Frees one node of either kind
+  static void freeNode(BNode *node) {
+    if (node->isLeaf) {
+      delete static_cast<LeafNode *>(node);
+    } else {
+      delete static_cast<InnerNode *>(node);
+    }
+  }
+
+  // Helper: Descends to the leaf whose range contains the Batch ID
+  LeafNode *findLeaf(uint64_t key, string_view batchID) {
+    BNode *current = root;
+    while (!current->isLeaf) {
+      InnerNode *node = static_cast<InnerNode *>(current);
+      current = node->children[childIndex(node, key, batchID)];
+    }
+    return static_cast<LeafNode *>(current);
+  }
+
+  // Helper: Splits the full child i of a non-full parent into two halves
+  // Leaf: the right half's first ID is copied up as the new separator
+  // Inner: the middle separator moves up and is removed from both halves
+  void splitChild(InnerNode *parent, int i) {
+    // 1. Open slot i in the parent (separator i, child i + 1)
+    for (int j = parent->count; j > i; j--) {
+      parent->keys[j] = parent->keys[j - 1];
+      parent->ids[j] = std::move(parent->ids[j - 1]);
+      parent->children[j + 1] = parent->children[j];
+    }
+
+    // 2. Move the upper half of the child into a new right sibling
+    if (parent->children[i]->isLeaf) {
+      LeafNode *leftLeaf = static_cast<LeafNode *>(parent->children[i]);
+      LeafNode *rightLeaf = new LeafNode();
+      int half = NODE_SLOTS / 2;
+      for (int j = half; j < NODE_SLOTS; j++) {
+        rightLeaf->keys[j - half] = leftLeaf->keys[j];
+        rightLeaf->records[j - half] = std::move(leftLeaf->records[j]);
+      }
+      rightLeaf->count = NODE_SLOTS - half;
+      leftLeaf->count = half;
+      rightLeaf->next = leftLeaf->next; // Keep the leaf chain intact
+      leftLeaf->next = rightLeaf;
+      setSeparator(parent, i, rightLeaf->keys[0],
+                   rightLeaf->records[0].batchID);
+      parent->children[i + 1] = rightLeaf;
+    } else {
+      InnerNode *leftNode = static_cast<InnerNode *>(parent->children[i]);
+      InnerNode *rightNode = new InnerNode();
+      int mid = NODE_SLOTS / 2;
+      rightNode->count = NODE_SLOTS - mid - 1;
+      for (int j = 0; j < rightNode->count; j++) {
+        rightNode->keys[j] = leftNode->keys[mid + 1 + j];
+        rightNode->ids[j] = std::move(leftNode->ids[mid + 1 + j]);
+        rightNode->children[j] = leftNode->children[mid + 1 + j];
+      }
+      rightNode->children[rightNode->count] = leftNode->children[NODE_SLOTS];
+      parent->keys[i] = leftNode->keys[mid];
+      parent->ids[i] = std::move(leftNode->ids[mid]);
+      leftNode->count = mid;
+      parent->children[i + 1] = rightNode;
+    }
+    parent->count++;
+  }
+
+  // Helper: Child i of the parent borrows the last entry of its left sibling
+  void borrowFromLeft(InnerNode *parent, int i) {
+    BNode *child = parent->children[i];
+    BNode *sibling = parent->children[i - 1];
+
+    if (child->isLeaf) {
+      LeafNode *leaf = static_cast<LeafNode *>(child);
+      LeafNode *leftLeaf = static_cast<LeafNode *>(sibling);
+      for (int j = leaf->count; j > 0; j--) {
+        leaf->keys[j] = leaf->keys[j - 1];
+        leaf->records[j] = std::move(leaf->records[j - 1]);
+      }
+      leaf->keys[0] = leftLeaf->keys[leftLeaf->count - 1];
+      leaf->records[0] = std::move(leftLeaf->records[leftLeaf->count - 1]);
+      setSeparator(parent, i - 1, leaf->keys[0], leaf->records[0].batchID);
+    } else {
+      // The separator rotates down into the child, the sibling's last key up
+      InnerNode *node = static_cast<InnerNode *>(child);
+      InnerNode *leftNode = static_cast<InnerNode *>(sibling);
+      node->children[node->count + 1] = node->children[node->count];
+      for (int j = node->count; j > 0; j--) {
+        node->keys[j] = node->keys[j - 1];
+        node->ids[j] = std::move(node->ids[j - 1]);
+        node->children[j] = node->children[j - 1];
+      }
+      node->keys[0] = parent->keys[i - 1];
+      node->ids[0] = std::move(parent->ids[i - 1]);
+      node->children[0] = leftNode->children[leftNode->count];
+      parent->keys[i - 1] = leftNode->keys[leftNode->count - 1];
+      parent->ids[i - 1] = std::move(leftNode->ids[leftNode->count - 1]);
+    }
+    sibling->count--;
+    child->count++;
+  }
+
+  // Helper: Child i of the parent borrows the first entry of its right
+  // sibling
+  void borrowFromRight(InnerNode *parent, int i) {
+    BNode *child = parent->children[i];
+    BNode *sibling = parent->children[i + 1];
+
+    if (child->isLeaf) {
+      LeafNode *leaf = static_cast<LeafNode *>(child);
+      LeafNode *rightLeaf = static_cast<LeafNode *>(sibling);
+      leaf->keys[leaf->count] = rightLeaf->keys[0];
+      leaf->records[leaf->count] = std::move(rightLeaf->records[0]);
+      for (int j = 0; j < rightLeaf->count - 1; j++) {
+        rightLeaf->keys[j] = rightLeaf->keys[j + 1];
+        rightLeaf->records[j] = std::move(rightLeaf->records[j + 1]);
+      }
+      setSeparator(parent, i, rightLeaf->keys[0],
+                   rightLeaf->records[0].batchID);
+    } else {
+      // The separator rotates down into the child, the sibling's first key up
+      InnerNode *node = static_cast<InnerNode *>(child);
+      InnerNode *rightNode = static_cast<InnerNode *>(sibling);
+      node->keys[node->count] = parent->keys[i];
+      node->ids[node->count] = std::move(parent->ids[i]);
+      node->children[node->count + 1] = rightNode->children[0];
+      parent->keys[i] = rightNode->keys[0];
+      parent->ids[i] = std::move(rightNode->ids[0]);
+      for (int j = 0; j < rightNode->count - 1; j++) {
+        rightNode->keys[j] = rightNode->keys[j + 1];
+        rightNode->ids[j] = std::move(rightNode->ids[j + 1]);
+        rightNode->children[j] = rightNode->children[j + 1];
+      }
+      rightNode->children[rightNode->count - 1] =
+          rightNode->children[rightNode->count];
+    }
+    sibling->count--;
+    child->count++;
+  }
+
+  // Helper: Merges child i + 1 of the parent into child i and removes
+  // separator i (the parent loses one key and may underflow in turn)
+  void mergeChildren(InnerNode *parent, int i) {
+    BNode *leftChild = parent->children[i];
+    BNode *rightChild = parent->children[i + 1];
+
+    if (leftChild->isLeaf) {
+      LeafNode *leftLeaf = static_cast<LeafNode *>(leftChild);
+      LeafNode *rightLeaf = static_cast<LeafNode *>(rightChild);
+      for (int j = 0; j < rightLeaf->count; j++) {
+        leftLeaf->keys[leftLeaf->count + j] = rightLeaf->keys[j];
+        leftLeaf->records[leftLeaf->count + j] =
+            std::move(rightLeaf->records[j]);
+      }
+      leftLeaf->count += rightLeaf->count;
+      leftLeaf->next = rightLeaf->next;
+    } else {
+      // The separator comes down between the two halves
+      InnerNode *leftNode = static_cast<InnerNode *>(leftChild);
+      InnerNode *rightNode = static_cast<InnerNode *>(rightChild);
+      int base = leftNode->count;
+      leftNode->keys[base] = parent->keys[i];
+      leftNode->ids[base] = std::move(parent->ids[i]);
+      for (int j = 0; j < rightNode->count; j++) {
+        leftNode->keys[base + 1 + j] = rightNode->keys[j];
+        leftNode->ids[base + 1 + j] = std::move(rightNode->ids[j]);
+      }
+      for (int j = 0; j <= rightNode->count; j++) {
+        leftNode->children[base + 1 + j] = rightNode->children[j];
+      }
+      leftNode->count = base + 1 + rightNode->count;
+    }
+    freeNode(rightChild);
+
+    // Close the gap in the parent
+    for (int j = i; j < parent->count - 1; j++) {
+      parent->keys[j] = parent->keys[j + 1];
+      parent->ids[j] = std::move(parent->ids[j + 1]);
+      parent->children[j + 1] = parent->children[j + 2];
+    }
+    parent->count--;
+  }
+
+  // Helper: Leftmost leaf (smallest Batch IDs), the start of the leaf chain
+  LeafNode *firstLeaf() {
+    if (root == nullptr)
+      return nullptr;
+    BNode *current = root;
+    while (!current->isLeaf) {
+      current = static_cast<InnerNode *>(current)->children[0];
+    }
+    return static_cast<LeafNode *>(current);
+  }
+
+public:
+  static constexpr const char *NAME = "B+ Tree";
+  static constexpr const char *RESULTS_FILE = "bplus_results.txt";
+  // Records shift inside the leaves, so no pointer to one stays valid
+  static constexpr bool STABLE_RECORDS = false;
+  static constexpr bool READ_ONLY_FIND = true; // find() changes nothing
+
+  // Forward iterator over the leaf chain (leaf, slot), in Batch ID order
+  // Note: Any add/remove invalidates existing iterators
+  class Iterator {
+  public:
+    Iterator() : leaf(nullptr), pos(0) {}
+    Iterator(LeafNode *start, int slot) : leaf(start), pos(slot) { skipEnd(); }
+
+    Medicine &operator*() const { return leaf->records[pos]; }
+    Medicine *operator->() const { return &leaf->records[pos]; }
+
+    // Encoded key of the current batch
+    uint64_t key() const { return leaf->keys[pos]; }
+
+    Iterator &operator++() {
+      pos++;
+      skipEnd();
+      return *this;
+    }
+
+    bool operator==(const Iterator &other) const {
+      return leaf == other.leaf && pos == other.pos;
+    }
+    bool operator!=(const Iterator &other) const { return !(*this == other); }
+
+  private:
+    LeafNode *leaf; // nullptr = end
+    int pos;
+
+    // Steps over the end of a leaf onto the next one
+    void skipEnd() {
+      while (leaf != nullptr && pos == leaf->count) {
+        leaf = leaf->next;
+        pos = 0;
+      }
+    }
+  };
+
+  // Constructor: Empty tree, fastest node search kernel
+  BPlusEngine() {
+    root = nullptr;
+    countLess = bestNodeSearch(&kernelName);
+  }
+  BPlusEngine(const BPlusEngine &) = delete;
+  BPlusEngine &operator=(const BPlusEngine &) = delete;
+  ~BPlusEngine() { clear(); }
+
+  // --- CORE OPERATIONS: INSERT, SEARCH, DELETE ---
+  // All of them are iterative; the tree is only ~log16(n) levels deep
+
+  // Iterative insert; the record is only moved into its leaf slot
+  // Logic: Full nodes are split on the way down, so the leaf reached at
+  // the bottom always has room and no parent ever needs to be revisited
+  // Returns the stored record (valid until the next add/delete), or nullptr
+  // (record untouched) if the Batch ID already exists
+  Medicine *insert(uint64_t key, Medicine &med) {
+    if (root == nullptr) {
+      root = new LeafNode();
+    }
+
+    // 1. A full root is split first: the tree grows in height at the top
+    if (root->count == NODE_SLOTS) {
+      InnerNode *newRoot = new InnerNode();
+      newRoot->children[0] = root;
+      splitChild(newRoot, 0);
+      root = newRoot;
+    }
+
+    // 2. Descend, splitting any full child before stepping into it
+    BNode *current = root;
+    while (!current->isLeaf) {
+      InnerNode *node = static_cast<InnerNode *>(current);
+      int i = childIndex(node, key, med.batchID);
+      if (node->children[i]->count == NODE_SLOTS) {
+        splitChild(node, i);
+        if (compareSeparator(key, med.batchID, node, i) >= 0) {
+          i++; // The ID belongs to the new right half
+        }
+      }
+      current = node->children[i];
+    }
+
+    // 3. Insert into the leaf, shifting larger IDs one slot right
+    LeafNode *leaf = static_cast<LeafNode *>(current);
+    int pos = leafPosition(leaf, key, med.batchID);
+    if (pos < leaf->count && compareRecord(key, med.batchID, leaf, pos) == 0)
+      return nullptr; // Duplicate Case: Batch ID already exists
+    for (int j = leaf->count; j > pos; j--) {
+      leaf->keys[j] = leaf->keys[j - 1];
+      leaf->records[j] = std::move(leaf->records[j - 1]);
+    }
+    leaf->keys[pos] = key;
+    leaf->records[pos] = std::move(med);
+    leaf->count++;
+    return &leaf->records[pos];
+  }
+
+  // Iterative search for a batch by ID
+  // Note: Records live inside the leaves and shift when batches are added
+  // or deleted, so the pointer is only valid until the next add/delete
+  // Time Complexity: O(log n), with one node (a few cache lines) per level
+  Medicine *find(uint64_t key, string_view batchID) {
+    if (root == nullptr)
+      return nullptr;
+    LeafNode *leaf = findLeaf(key, batchID);
+    int pos = leafPosition(leaf, key, batchID);
+    if (pos < leaf->count && compareRecord(key, batchID, leaf, pos) == 0) {
+      return &leaf->records[pos];
+    }
+    return nullptr;
+  }
+
+  // Iterative delete
+  // Logic: Remove the record from its leaf, then walk back up the recorded
+  // path fixing underflow (borrow from a sibling, else merge with it)
+  // Note: Separators may keep naming a deleted ID; they still route
+  // correctly, because they only have to bound their children's ranges
+  bool remove(uint64_t key, string_view batchID) {
+    if (root == nullptr)
+      return false;
+
+    // 1. Navigation phase: Find the leaf, remembering the path to it
+    InnerNode *path[MAX_DEPTH];
+    int slot[MAX_DEPTH];
+    int depth = 0;
+    BNode *current = root;
+    while (!current->isLeaf) {
+      InnerNode *node = static_cast<InnerNode *>(current);
+      int i = childIndex(node, key, batchID);
+      path[depth] = node;
+      slot[depth] = i;
+      depth++;
+      current = node->children[i];
+    }
+    LeafNode *leaf = static_cast<LeafNode *>(current);
+    int pos = leafPosition(leaf, key, batchID);
+    if (pos == leaf->count || compareRecord(key, batchID, leaf, pos) != 0)
+      return false;
+
+    // 2. Remove the record, shifting larger IDs one slot left
+    for (int j = pos; j < leaf->count - 1; j++) {
+      leaf->keys[j] = leaf->keys[j + 1];
+      leaf->records[j] = std::move(leaf->records[j + 1]);
+    }
+    leaf->count--;
+
+    // 3. Fix underflow bottom-up; a borrow always ends the walk
+    while (depth > 0) {
+      int minKeys = current->isLeaf ? MIN_LEAF_KEYS : MIN_INNER_KEYS;
+      if (current->count >= minKeys)
+        break;
+      InnerNode *parent = path[depth - 1];
+      int i = slot[depth - 1];
+      if (i > 0 && parent->children[i - 1]->count > minKeys) {
+        borrowFromLeft(parent, i);
+        break;
+      }
+      if (i < parent->count && parent->children[i + 1]->count > minKeys) {
+        borrowFromRight(parent, i);
+        break;
+      }
+      mergeChildren(parent, (i > 0) ? i - 1 : i);
+      current = parent;
+      depth--;
+    }
+
+    // 4. Shrink the tree from the top once the root runs empty
+    if (!root->isLeaf && root->count == 0) {
+      InnerNode *oldRoot = static_cast<InnerNode *>(root);
+      root = oldRoot->children[0];
+      freeNode(oldRoot);
+    } else if (root->isLeaf && root->count == 0) {
+      freeNode(root);
+      root = nullptr;
+    }
+    return true;
+  }
+
+  // In-Order Traversal: calls visit(Medicine &) in Batch ID order
+  // Follows the leaf chain, so no stack or recursion is needed
+  template <class Visit> void forEach(Visit visit) {
+    for (LeafNode *leaf = firstLeaf(); leaf != nullptr; leaf = leaf->next) {
+      for (int i = 0; i < leaf->count; i++) {
+        visit(leaf->records[i]);
+      }
+    }
+  }
+
+  // Empties the whole tree (explicit stack, no recursion)
+  void clear() {
+    vector<BNode *> stack;
+    if (root != nullptr) {
+      stack.push_back(root);
+    }
+    while (!stack.empty()) {
+      BNode *node = stack.back();
+      stack.pop_back();
+      if (!node->isLeaf) {
+        InnerNode *inner = static_cast<InnerNode *>(node);
+        for (int i = 0; i <= inner->count; i++) {
+          stack.push_back(inner->children[i]);
+        }
+      }
+      freeNode(node);
+    }
+    root = nullptr;
+  }
+
+  bool empty() const { return root == nullptr; }
+
+  // --- OPTIONAL EXTRAS ---
+  // Number of levels from the root down to the leaves
+  int height() {
+    int height = 0;
+    BNode *current = root;
+    while (current != nullptr) {
+      height++;
+      if (current->isLeaf)
+        break;
+      current = static_cast<InnerNode *>(current)->children[0];
+    }
+    return height;
+  }
+
+  // Switches between the SIMD node search kernel and the scalar loop
+  // Note: Both give the same answers, so the tree is kept as it is
+  void setSimdEnabled(bool enabled) {
+    if (enabled) {
+      countLess = bestNodeSearch(&kernelName);
+    } else {
+      countLess = countLessScalar;
+      kernelName = "Scalar";
+    }
+  }
+
+  const char *simdKernel() const { return kernelName; }
+
+  // Ordered iteration
+  Iterator begin() { return Iterator(firstLeaf(), 0); }
+  Iterator end() { return Iterator(); }
+
+  // First batch >= (key, batchID), or > it when 'strict' is set
+  // The lower bound is in the leaf the descent reaches, or is the first
+  // batch of the next leaf
+  Iterator bound(uint64_t key, string_view batchID, bool strict) {
+    if (root == nullptr)
+      return end();
+    LeafNode *leaf = findLeaf(key, batchID);
+    int pos = leafPosition(leaf, key, batchID);
+    if (strict && pos < leaf->count &&
+        compareRecord(key, batchID, leaf, pos) == 0) {
+      pos++;
+    }
+    return Iterator(leaf, pos);
+  }
+};
+
+#endif
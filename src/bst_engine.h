@@ -0,0 +1,209 @@
+/*
+ * Name: Lau Su Hui (Abby)
+ * Matric No.: MEC245045
+ * Semester: 20252026-1
+ * Course: MECS1023 ADSA
+ * Group & Theme: Group 1-Pharmacy Inventory Control System
+ * Assignment Title: Medicine Management System (Solution 1-BST Engine)
+ */
+
+#ifndef BST_ENGINE_H
+#define BST_ENGINE_H
+
+#include "task_pool.h"
+#include "tree_nodes.h"
+
+// This structure represents a "Node" in the Binary Search Tree (BST)
+struct BSTNode {
+  uint64_t key;   // Encoded Batch ID (or STRING_KEY), compared first
+  Medicine data;  // The medicine details
+  BSTNode *left;  // Pointer to left child (smaller Batch ID)
+  BSTNode *right; // Pointer to right child (larger Batch ID)
+
+  // Constructor to initialise a node with data and null pointers
+  // The record is moved in, so its strings are never deep-copied
+  BSTNode(Medicine &&med, uint64_t code) : data(std::move(med)) { init(code); }
+
+  void init(uint64_t code) {
+    key = code;
+    left = nullptr;
+    right = nullptr;
+  }
+};
+
+// ==========================================
+// BST ENGINE (PLUGS INTO MedicineManager)
+// ==========================================
+
+// COUNT_WORK = true compiles in the work counters (see BSTEngine and
+// CountingBSTEngine below)
+template <bool COUNT_WORK>
+class BasicBSTEngine
+    : public LinkedTreeEngine<BasicBSTEngine<COUNT_WORK>, BSTNode> {
+private:
+  typedef LinkedTreeEngine<BasicBSTEngine, BSTNode> Base;
+  friend Base; // Calls nodesChanged()
+  using Base::createNode;
+  using Base::destroyNode;
+  using Base::root; // The root pointer of the BST
+
+  FrozenIndex<BSTNode> frozen;  // Read-optimised snapshot (freeze())
+  WorkCounter<COUNT_WORK> work; // Comparisons and visits (if compiled in)
+
+  // Three-way comparison of a (key, Batch ID) pair against a node
+  int compareKey(uint64_t key, string_view batchID, const BSTNode *node) {
+    work.compared();
+    return compareKeys(key, batchID, node->key, node->data.batchID);
+  }
+
+  // Any node added or released drops the frozen snapshot, which no longer
+  // matches the tree
+  void nodesChanged() { frozen.clear(); }
+
+  // Iterative helper to search for a batch by ID
+  // Time Complexity: O(log n) on average, O(n) worst case
+  BSTNode *searchInternal(uint64_t key, string_view batchID) {
+    BSTNode *current = root;
+    while (current != nullptr) {
+      work.visited();
+      // Binary Search Logic: Found it, or navigate Left or Right
+      int cmp = compareKey(key, batchID, current);
+      if (cmp == 0) {
+        return current;
+      }
+      current = (cmp < 0) ? current->left : current->right;
+    }
+    return nullptr; // Reached dead end of the tree
+  }
+
+public:
+  static constexpr const char *NAME = "BST";
+  static constexpr const char *RESULTS_FILE = "bst_results_task4.txt";
+  static constexpr bool STABLE_RECORDS = true; // Nodes never move
+  // find() changes nothing, unless it has work counters to bump
+  static constexpr bool READ_ONLY_FIND = !COUNT_WORK;
+  typedef BasicBSTEngine<true> Counting; // Same engine, counting its work
+
+  // --- CORE OPERATIONS: INSERT, SEARCH, DELETE ---
+  // All of them are iterative: sorted arrivals turn the BST into a long
+  // chain, and a recursive descent would overflow the call stack on it
+
+  // Iterative insert; the record is only moved into the new node
+  // Logic: Smaller Batch IDs go Left, Larger Batch IDs go Right
+  // 'link' points at the child pointer to follow, so the new node can be
+  // hooked in without remembering the parent
+  // Returns the stored record, or nullptr (record untouched) if the Batch ID
+  // already exists
+  Medicine *insert(uint64_t key, Medicine &med) {
+    BSTNode **link = &root;
+    while (*link != nullptr) {
+      work.visited();
+      int cmp = compareKey(key, med.batchID, *link);
+      if (cmp < 0) {
+        link = &(*link)->left; // Go Left (Smaller)
+      } else if (cmp > 0) {
+        link = &(*link)->right; // Go Right (Larger)
+      } else {
+        return nullptr; // Duplicate Case: Batch ID already exists
+      }
+    }
+    // Empty spot reached: create the new node here
+    *link = createNode(std::move(med), key);
+    return &(*link)->data;
+  }
+
+  // Search; packed keys are served by the frozen snapshot while it is valid
+  Medicine *find(uint64_t key, string_view batchID) {
+    BSTNode *result = (frozen.active() && key != STRING_KEY)
+                          ? frozen.find(key)
+                          : searchInternal(key, batchID);
+    return (result != nullptr) ? &result->data : nullptr;
+  }
+
+  // Iterative delete; nodes are relinked, so no record is ever copied
+  bool remove(uint64_t key, string_view batchID) {
+    // 1. Navigation phase: Find the link that points at the node to delete
+    BSTNode **link = &root;
+    while (*link != nullptr) {
+      work.visited();
+      int cmp = compareKey(key, batchID, *link);
+      if (cmp == 0)
+        break;
+      link = (cmp < 0) ? &(*link)->left : &(*link)->right;
+    }
+    BSTNode *target = *link;
+    if (target == nullptr)
+      return false;
+
+    // 2. The node is found. Handle the 3 Deletion Cases:
+    // Case 1 & Case 2: Only one child or no child
+    if (target->left == nullptr) {
+      *link = target->right;
+    } else if (target->right == nullptr) {
+      *link = target->left;
+    } else {
+      // Case 3: Two children
+      // Unlink the In-Order Successor (smallest node in right subtree)
+      // and relink it in place of the deleted node
+      BSTNode **successorLink = &target->right;
+      work.visited();
+      while ((*successorLink)->left != nullptr) {
+        successorLink = &(*successorLink)->left;
+        work.visited();
+      }
+      BSTNode *successor = *successorLink;
+      *successorLink = successor->right; // Its right subtree takes its place
+      successor->left = target->left;
+      successor->right = target->right;
+      *link = successor;
+    }
+    destroyNode(target);
+    return true;
+  }
+
+  // forEach, clear, empty, reduce, setPoolEnabled and the ordered
+  // iterators come from LinkedTreeEngine (tree_nodes.h)
+
+  // --- OPTIONAL EXTRAS ---
+  // Number of levels from the root down to the deepest leaf
+  int height() { return subtreeHeight(root); }
+
+  // Bulk load: merges (key, record) pairs sorted by Batch ID with the
+  // stored nodes and relinks everything into a perfectly balanced tree
+  // Duplicates are skipped (first one wins); added records are moved from
+  // With a pool, the tree is linked up by all of its threads
+  // Returns the number of batches added
+  size_t bulkLoad(vector<pair<uint64_t, Medicine *>> &incoming,
+                  TaskPool *pool = nullptr) {
+    size_t added;
+    vector<BSTNode *> merged = mergeSortedNodes(
+        root, incoming,
+        [this](uint64_t key, string_view batchID, const BSTNode *node) {
+          return compareKey(key, batchID, node);
+        },
+        [this](Medicine &&med, uint64_t key) {
+          return createNode(std::move(med), key);
+        },
+        added);
+    root = linkBalanced(merged, 0, merged.size(), [](BSTNode *) {}, pool);
+    return added;
+  }
+
+  // Exports the tree into the frozen snapshot (until the next add/delete)
+  void freeze() { frozen.build(root); }
+  bool isFrozen() const { return frozen.active(); }
+
+  // --- TREE SHAPE & WORK COUNTERS ---
+  // Height, average depth and nodes per depth, by walking every node
+  TreeStats treeStats() { return collectTreeStats(root); }
+
+  // Comparisons and visits since the last reset (all zero unless this is
+  // the Counting engine); lookups served by the frozen snapshot skip them
+  WorkCounts workCounts() const { return work.get(); }
+  void resetWorkCounts() { work.reset(); }
+};
+
+typedef BasicBSTEngine<false> BSTEngine;        // No counting code at all
+typedef BasicBSTEngine<true> CountingBSTEngine; // Counts its work
+
+#endif
@@ -0,0 +1,147 @@
+/*
+ * Name: Lau Su Hui (Abby)
+ * Matric No.: MEC245045
+ * Semester: 20252026-1
+ * Course: MECS1023 ADSA
+ * Group & Theme: Group 1-Pharmacy Inventory Control System
+ * Assignment Title: Medicine Management System (Concurrent Sharded Manager)
+ */
+
+#ifndef CONCURRENT_MANAGER_H
+#define CONCURRENT_MANAGER_H
+
+#include <algorithm>    // For sort (ordered listings)
+#include <functional>   // For hash<string_view>
+#include <memory>       // For unique_ptr (shards cannot move)
+#include <mutex>        // For unique_lock (writers)
+#include <shared_mutex> // For shared_mutex, shared_lock (readers)
+#include <string_view>
+#include <vector>
+
+#include "medicine_manager.h"
+
+// ==========================================
+// CONCURRENT MANAGER (MANY PHARMACY COUNTERS)
+// ==========================================
+
+// Thread-safe Medicine Management System for several counters at once
+// Logic: The Batch IDs are split by hash into N shards, each its own
+// MedicineManager (e.g., an AVL tree) behind its own reader-writer lock.
+// Lookups take the shard's lock shared, so any number of them run in
+// parallel; adds and deletes take it exclusive, but only for their own
+// shard, so writes to different shards never wait for each other.
+// Note: Readers share a lock, so Engine::find must not modify the engine
+// (Engine::READ_ONLY_FIND). The splay tree restructures itself on every
+// search, and the Counting BST / AVL engines bump their work counters,
+// so neither can be used here. The shards also never turn on latency
+// tracking, which would record into one histogram from many readers
+template <class Engine> class ConcurrentMedicineManager {
+  static_assert(Engine::READ_ONLY_FIND,
+                "Shared-lock readers need an engine whose find() writes "
+                "nothing");
+
+private:
+  // One independently locked part of the key space
+  // alignas(64): neighbouring locks never share a cache line
+  struct alignas(64) Shard {
+    shared_mutex lock;
+    MedicineManager<Engine> manager;
+  };
+
+  vector<unique_ptr<Shard>> shards;
+
+  // Shard of a Batch ID
+  // Logic: The hash is scrambled (Fibonacci hashing) and its high bits are
+  // used, so the low bits stay evenly spread for a shard's own hash index
+  size_t shardOf(string_view batchID) const {
+    uint64_t h = hash<string_view>()(batchID);
+    return ((h * 0x9E3779B97F4A7C15ULL) >> 32) % shards.size();
+  }
+
+public:
+  // Constructor: 'shardCount' empty shards (at least one)
+  explicit ConcurrentMedicineManager(size_t shardCount) {
+    if (shardCount < 1)
+      shardCount = 1;
+    for (size_t i = 0; i < shardCount; i++) {
+      shards.push_back(make_unique<Shard>());
+    }
+  }
+
+  size_t shardCount() const { return shards.size(); }
+
+  // Turns the hash index on or off in every shard (empties them first)
+  void setHashIndexEnabled(bool enabled) {
+    for (auto &shard : shards) {
+      unique_lock<shared_mutex> guard(shard->lock);
+      shard->manager.setHashIndexEnabled(enabled);
+    }
+  }
+
+  // Public Interface for Insertion (exclusive lock on one shard)
+  // Returns false if the Batch ID already exists (no message printed)
+  bool addMedicine(const Medicine &med) {
+    Shard &shard = *shards[shardOf(med.batchID)];
+    unique_lock<shared_mutex> guard(shard.lock);
+    return shard.manager.addMedicine(med, false);
+  }
+
+  // Public Interface for Search (shared lock on one shard)
+  // The record is copied out while the lock is held, since another
+  // counter may delete the batch right afterwards
+  bool findMedicine(string_view batchID, Medicine &out) const {
+    Shard &shard = *shards[shardOf(batchID)];
+    shared_lock<shared_mutex> guard(shard.lock);
+    const Medicine *found = shard.manager.findMedicine(batchID);
+    if (found == nullptr)
+      return false;
+    out = *found;
+    return true;
+  }
+
+  // Public Interface for Deletion (exclusive lock on one shard)
+  bool removeMedicine(string_view batchID) {
+    Shard &shard = *shards[shardOf(batchID)];
+    unique_lock<shared_mutex> guard(shard.lock);
+    return shard.manager.removeMedicine(batchID);
+  }
+
+  // Calls visit(const Medicine &) for every batch, one shard at a time
+  // (Batch ID order within a shard only), holding that shard's shared lock
+  // for the whole walk, so its adds and deletes wait until it is done
+  template <class Visit> void forEachMedicine(Visit visit) const {
+    for (const auto &shard : shards) {
+      shared_lock<shared_mutex> guard(shard->lock);
+      shard->manager.forEachMedicine(
+          [&visit](const Medicine &med) { visit(med); });
+    }
+  }
+
+  // Copies every batch out in Batch ID order (for reports and display)
+  // Each shard is read under its shared lock in turn, so every record is
+  // consistent, but batches added meanwhile to shards already copied are
+  // not included
+  vector<Medicine> snapshot() const {
+    vector<Medicine> all;
+    for (const auto &shard : shards) {
+      shared_lock<shared_mutex> guard(shard->lock);
+      shard->manager.forEachMedicine(
+          [&all](const Medicine &med) { all.push_back(med); });
+    }
+    sort(all.begin(), all.end(), [](const Medicine &a, const Medicine &b) {
+      return compareKeys(encodeBatchID(a.batchID), a.batchID,
+                         encodeBatchID(b.batchID), b.batchID) < 0;
+    });
+    return all;
+  }
+
+  // Empties every shard
+  void clear() {
+    for (auto &shard : shards) {
+      unique_lock<shared_mutex> guard(shard->lock);
+      shard->manager.clear();
+    }
+  }
+};
+
+#endif
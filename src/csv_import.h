@@ -0,0 +1,186 @@
+/*
+ * Name: Lau Su Hui (Abby)
+ * Matric No.: MEC245045
+ * Semester: 20252026-1
+ * Course: MECS1023 ADSA
+ * Group & Theme: Group 1-Pharmacy Inventory Control System
+ * Assignment Title: Medicine Management System (Streaming CSV Reader)
+ */
+
+#ifndef CSV_IMPORT_H
+#define CSV_IMPORT_H
+
+#include <cctype>  // For tolower (header row check)
+#include <cstdio>  // For FILE, fread (chunked reading)
+#include <cstring> // For memmove (carry a partial row over)
+#include <deque>   // For the "" buffers (growing never moves them)
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "medicine_common.h"
+
+// ==========================================
+// STREAMING CSV READER (SUPPLIER STOCK FILES)
+// ==========================================
+
+// True if a row's first field is the "Batch ID" column title (any case,
+// after an optional UTF-8 byte order mark, as spreadsheet exports add)
+// Only such a first row counts as a header; anything else is data
+inline bool isBatchIdHeader(string_view field) {
+  const string_view BOM = "\xEF\xBB\xBF";
+  const string_view TITLE = "batch id";
+  if (field.substr(0, BOM.size()) == BOM)
+    field.remove_prefix(BOM.size());
+  if (field.size() != TITLE.size())
+    return false;
+  for (size_t i = 0; i < field.size(); i++) {
+    if (tolower((unsigned char)field[i]) != TITLE[i])
+      return false;
+  }
+  return true;
+}
+
+// Reads a CSV file in large chunks and hands every row to a callback as
+// string_views into the chunk, so no string is built per field
+// Format: comma-separated, one row per line (\n or \r\n); a field may be
+// wrapped in double quotes to hold commas, line breaks or "" (one quote).
+// Only fields with "" inside are copied (into per-column buffers that are
+// reused from row to row).
+class CsvReader {
+private:
+  static const size_t CHUNK_SIZE = 1 << 20; // 1 MB per read
+
+  vector<char> buffer;        // The chunk (plus a carried-over row)
+  vector<string_view> fields; // Fields of the current row
+  deque<string> unescaped;    // Per-column buffers for "" fields
+  size_t lineNumber;          // Line where the current row starts
+
+  // Parses one row starting at p into 'fields' ('lines': lines it spans)
+  // Returns the position after the row, or nullptr if the row runs past
+  // 'end' and more data is needed (atEof: the file ends at 'end', so the
+  // last row is taken as it is, even with an unclosed quote)
+  const char *parseRow(const char *p, const char *end, bool atEof,
+                       size_t &lines) {
+    fields.clear();
+    lines = 1;
+    while (true) {
+      size_t column = fields.size();
+      if (p < end && *p == '"') {
+        // Quoted field: runs to the closing quote ("" = one quote)
+        const char *start = ++p;
+        bool escaped = false;
+        while (p < end) {
+          if (*p == '"') {
+            if (p + 1 == end && !atEof)
+              return nullptr; // Cannot tell "" from " yet
+            if (p + 1 < end && p[1] == '"') {
+              escaped = true;
+              p += 2;
+              continue;
+            }
+            break;
+          }
+          if (*p == '\n')
+            lines++;
+          p++;
+        }
+        if (p == end && !atEof)
+          return nullptr; // The closing quote is in the next chunk
+        string_view raw(start, p - start);
+        if (p < end)
+          p++; // Closing quote
+        if (escaped) {
+          while (unescaped.size() <= column) {
+            unescaped.emplace_back();
+          }
+          string &out = unescaped[column];
+          out.clear();
+          for (size_t i = 0; i < raw.size(); i++) {
+            out.push_back(raw[i]);
+            if (raw[i] == '"')
+              i++; // Skip the second quote of ""
+          }
+          raw = out;
+        }
+        fields.push_back(raw);
+        // Anything up to the next separator after the quote is ignored
+        while (p < end && *p != ',' && *p != '\n') {
+          p++;
+        }
+      } else {
+        const char *start = p;
+        while (p < end && *p != ',' && *p != '\n') {
+          p++;
+        }
+        if (p == end && !atEof)
+          return nullptr;
+        const char *stop = p;
+        if (stop > start && stop[-1] == '\r')
+          stop--; // Windows line ending
+        fields.push_back(string_view(start, stop - start));
+      }
+      if (p == end) {
+        if (!atEof)
+          return nullptr;
+        return p;
+      }
+      if (*p == '\n')
+        return p + 1;
+      p++; // Separator: the next field follows
+    }
+  }
+
+public:
+  CsvReader() : lineNumber(0) {}
+
+  // Calls onRow(const vector<string_view> &fields, size_t lineNumber)
+  // for every non-empty row, in file order; the views are only valid
+  // during the call
+  // Returns false if the file cannot be opened or read
+  template <class OnRow> bool read(const string &path, OnRow onRow) {
+    FILE *file = fopen(path.c_str(), "rb");
+    if (file == nullptr)
+      return false;
+    buffer.resize(CHUNK_SIZE);
+    size_t filled = 0; // Bytes of 'buffer' holding data
+    size_t used = 0;   // Bytes already parsed
+    bool atEof = false;
+    lineNumber = 1;
+
+    while (true) {
+      // 1. Parse every complete row in the buffer
+      const char *end = buffer.data() + filled;
+      while (used < filled) {
+        const char *row = buffer.data() + used;
+        size_t lines = 1;
+        const char *next = parseRow(row, end, atEof, lines);
+        if (next == nullptr)
+          break; // Partial row: needs the next chunk
+        if (!(fields.size() == 1 && fields[0].empty()))
+          onRow(fields, lineNumber); // Skips blank lines
+        lineNumber += lines;
+        used = next - buffer.data();
+      }
+      if (atEof)
+        break;
+
+      // 2. Carry the partial row to the front (growing the buffer if one
+      // row is bigger than it) and read the next chunk behind it
+      size_t rest = filled - used;
+      memmove(buffer.data(), buffer.data() + used, rest);
+      if (rest == buffer.size())
+        buffer.resize(buffer.size() * 2);
+      filled = rest + fread(buffer.data() + rest, 1, buffer.size() - rest,
+                            file);
+      used = 0;
+      if (feof(file) || ferror(file))
+        atEof = true; // This is the last chunk
+    }
+    bool ok = !ferror(file);
+    fclose(file);
+    return ok;
+  }
+};
+
+#endif
@@ -0,0 +1,145 @@
+/*
+ * Name: Lau Su Hui (Abby)
+ * Matric No.: MEC245045
+ * Semester: 20252026-1
+ * Course: MECS1023 ADSA
+ * Group & Theme: Group 1-Pharmacy Inventory Control System
+ * Assignment Title: Medicine Management System (Batch ID Hash Index)
+ */
+
+#ifndef HASH_INDEX_H
+#define HASH_INDEX_H
+
+#include <functional> // For hash<string_view>
+#include <vector>
+
+#include "medicine_common.h"
+
+// Open-addressing hash index from Batch ID to the record stored in the tree
+// Logic: One flat array of (hash, record) slots with linear probing, so an
+// exact lookup is one hash plus, on average, one or two neighbouring slots
+// (usually the same cache line) instead of a log2(n)-deep tree descent.
+// The full hash is kept in every slot: mismatches are rejected without
+// touching the record, and growing never re-reads any Batch ID.
+// Note: It only stores pointers, so the records must never move (engines
+// with STABLE_RECORDS); the owner keeps it in step on every add/delete
+class BatchHashIndex {
+private:
+  struct Slot {
+    size_t hash;      // hash<string_view> of the Batch ID
+    Medicine *record; // nullptr = empty slot
+  };
+
+  static const size_t MIN_SLOTS = 16; // Power of two
+
+  vector<Slot> slots; // Size is a power of two (or 0 before the first add)
+  size_t count;       // Slots in use
+
+  static size_t hashOf(string_view batchID) {
+    return hash<string_view>()(batchID);
+  }
+
+  // Doubles the table once it is 70% full and re-places every record
+  void grow() {
+    vector<Slot> old;
+    old.swap(slots);
+    slots.assign(old.empty() ? MIN_SLOTS : old.size() * 2, Slot{0, nullptr});
+    size_t mask = slots.size() - 1;
+    for (const Slot &s : old) {
+      if (s.record == nullptr)
+        continue;
+      size_t i = s.hash & mask;
+      while (slots[i].record != nullptr) {
+        i = (i + 1) & mask;
+      }
+      slots[i] = s;
+    }
+  }
+
+public:
+  BatchHashIndex() : count(0) {}
+
+  // Record of a Batch ID, or nullptr if it is not indexed
+  Medicine *find(string_view batchID) const {
+    if (slots.empty())
+      return nullptr;
+    size_t h = hashOf(batchID);
+    size_t mask = slots.size() - 1;
+    for (size_t i = h & mask; slots[i].record != nullptr; i = (i + 1) & mask) {
+      if (slots[i].hash == h && slots[i].record->batchID == batchID)
+        return slots[i].record;
+    }
+    return nullptr;
+  }
+
+  // Adds a record whose Batch ID is not indexed yet
+  void insert(Medicine *record) {
+    if ((count + 1) * 10 > slots.size() * 7) {
+      grow();
+    }
+    size_t h = hashOf(record->batchID);
+    size_t mask = slots.size() - 1;
+    size_t i = h & mask;
+    while (slots[i].record != nullptr) {
+      i = (i + 1) & mask;
+    }
+    slots[i] = Slot{h, record};
+    count++;
+  }
+
+  // Points the slot of 'old' at 'record', which holds the same Batch ID
+  // (the engine stored the batch anew). Slots are matched by pointer, so
+  // 'old' is never read and may already be freed
+  void replace(const Medicine *old, Medicine *record) {
+    size_t mask = slots.size() - 1;
+    size_t i = hashOf(record->batchID) & mask;
+    while (slots[i].record != old) {
+      i = (i + 1) & mask;
+    }
+    slots[i].record = record;
+  }
+
+  // Removes a Batch ID; returns false if it was not indexed
+  // Logic: Backward-shift deletion. Later slots of the same probe run are
+  // moved up into the hole, so lookups never need "deleted" markers
+  bool erase(string_view batchID) {
+    if (slots.empty())
+      return false;
+    size_t h = hashOf(batchID);
+    size_t mask = slots.size() - 1;
+    size_t hole = h & mask;
+    while (true) {
+      if (slots[hole].record == nullptr)
+        return false;
+      if (slots[hole].hash == h && slots[hole].record->batchID == batchID)
+        break;
+      hole = (hole + 1) & mask;
+    }
+
+    for (size_t next = (hole + 1) & mask; slots[next].record != nullptr;
+         next = (next + 1) & mask) {
+      // A slot may fill the hole if its home position is not after the
+      // hole (cyclically) on the way to where it sits now
+      size_t home = slots[next].hash & mask;
+      if (((next - home) & mask) >= ((next - hole) & mask)) {
+        slots[hole] = slots[next];
+        hole = next;
+      }
+    }
+    slots[hole].record = nullptr;
+    count--;
+    return true;
+  }
+
+  // Forgets every record (the table keeps its size for the next fill)
+  void clear() {
+    if (count > 0) {
+      slots.assign(slots.size(), Slot{0, nullptr});
+    }
+    count = 0;
+  }
+
+  size_t size() const { return count; }
+};
+
+#endif
@@ -0,0 +1,149 @@
+/*
+ * Name: Lau Su Hui (Abby)
+ * Matric No.: MEC245045
+ * Semester: 20252026-1
+ * Course: MECS1023 ADSA
+ * Group & Theme: Group 1-Pharmacy Inventory Control System
+ * Assignment Title: Medicine Management System (Latency Histograms)
+ */
+
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <chrono> // For steady_clock (one reading per operation edge)
+#include <cstdint>
+#include <cstring> // For memset (reset)
+#include <ostream>
+
+using namespace std;
+
+// ==========================================
+// LATENCY HISTOGRAMS (TAIL LATENCY)
+// ==========================================
+
+// Counts operation times (ns) in log-spaced buckets, HDR histogram style
+// Logic: Every power of two [2^k, 2^(k+1)) is split into 32 equal
+// sub-buckets, so a bucket is never wider than 1/32 (about 3%) of its
+// values; times below 32 ns get one bucket each. Recording is a bit scan
+// plus one counter increment, with no allocation, so it is cheap enough
+// to stay on all the time. Times from 2^40 ns (about 18 minutes) up share
+// one overflow bucket; the exact maximum is kept separately.
+class LatencyHistogram {
+private:
+  static const int SUB_BITS = 5;              // 32 sub-buckets per power
+  static const int SUB_COUNT = 1 << SUB_BITS; // of two
+  static const int MAX_BITS = 40;             // Values >= 2^40: overflow
+  static const int BUCKETS = (MAX_BITS - SUB_BITS + 1) * SUB_COUNT + 1;
+
+  uint64_t counts[BUCKETS];
+  uint64_t total;   // Values recorded
+  uint64_t maximum; // Largest value recorded (exact)
+  uint64_t latest;  // Last value recorded (e.g., for one menu action)
+  long double sum;  // For the mean
+
+  static int bucketOf(uint64_t ns) {
+    if (ns < (uint64_t)SUB_COUNT)
+      return (int)ns;
+    int power = 63 - __builtin_clzll(ns); // Highest set bit (>= SUB_BITS)
+    if (power >= MAX_BITS)
+      return BUCKETS - 1; // Overflow bucket
+    int shift = power - SUB_BITS;
+    return (shift + 1) * SUB_COUNT + (int)((ns >> shift) - SUB_COUNT);
+  }
+
+  // Largest value that falls into bucket b
+  static uint64_t bucketTop(int b) {
+    if (b == BUCKETS - 1)
+      return UINT64_MAX; // Overflow: capped at the maximum by the caller
+    if (b < SUB_COUNT)
+      return (uint64_t)b;
+    int shift = b / SUB_COUNT - 1;
+    uint64_t low = (uint64_t)(b % SUB_COUNT + SUB_COUNT) << shift;
+    return low + ((uint64_t)1 << shift) - 1;
+  }
+
+public:
+  LatencyHistogram() { reset(); }
+
+  void reset() {
+    memset(counts, 0, sizeof(counts));
+    total = 0;
+    maximum = 0;
+    latest = 0;
+    sum = 0;
+  }
+
+  void record(uint64_t ns) {
+    counts[bucketOf(ns)]++;
+    total++;
+    sum += ns;
+    latest = ns;
+    if (ns > maximum)
+      maximum = ns;
+  }
+
+  // Adds every value of another histogram (e.g., from another shard)
+  void merge(const LatencyHistogram &other) {
+    for (int b = 0; b < BUCKETS; b++) {
+      counts[b] += other.counts[b];
+    }
+    total += other.total;
+    sum += other.sum;
+    if (other.maximum > maximum)
+      maximum = other.maximum;
+  }
+
+  uint64_t count() const { return total; }
+  uint64_t max() const { return maximum; }
+  uint64_t last() const { return latest; }
+  double mean() const { return total ? (double)(sum / total) : 0; }
+
+  // The value that 'percent' % of the values are at or below, rounded up
+  // to the top of its bucket (but never above the maximum); 0 if empty
+  uint64_t percentile(double percent) const {
+    if (total == 0)
+      return 0;
+    uint64_t rank = (uint64_t)(percent / 100 * total + 0.999999);
+    if (rank < 1)
+      rank = 1;
+    uint64_t seen = 0;
+    for (int b = 0; b < BUCKETS; b++) {
+      seen += counts[b];
+      if (seen >= rank)
+        return bucketTop(b) < maximum ? bucketTop(b) : maximum;
+    }
+    return maximum;
+  }
+
+  // One line: "<label> Latency (ns): n=..., p50 ..., ..., max ..."
+  void writeSummary(ostream &out, const char *label) const {
+    out << label << " Latency (ns): n=" << total << ", p50 " << percentile(50)
+        << ", p90 " << percentile(90) << ", p99 " << percentile(99)
+        << ", p99.9 " << percentile(99.9) << ", max " << maximum << endl;
+  }
+};
+
+// Times the enclosing scope into a histogram (nothing if 'enabled' is
+// false, so the switch costs one branch)
+class LatencyTimer {
+private:
+  LatencyHistogram *histogram; // nullptr = not timing
+  chrono::steady_clock::time_point start;
+
+public:
+  LatencyTimer(LatencyHistogram &target, bool enabled)
+      : histogram(enabled ? &target : nullptr) {
+    if (histogram)
+      start = chrono::steady_clock::now();
+  }
+  LatencyTimer(const LatencyTimer &) = delete;
+  LatencyTimer &operator=(const LatencyTimer &) = delete;
+  ~LatencyTimer() {
+    if (histogram)
+      histogram->record((uint64_t)chrono::duration_cast<chrono::nanoseconds>(
+                            chrono::steady_clock::now() - start)
+                            .count());
+  }
+};
+
+#endif
@@ -0,0 +1,246 @@
+/*
+ * Name: Lau Su Hui (Abby)
+ * Matric No.: MEC245045
+ * Semester: 20252026-1
+ * Course: MECS1023 ADSA
+ * Group & Theme: Group 1-Pharmacy Inventory Control System
+ * Assignment Title: Medicine Management System (Shared Definitions)
+ */
+
+#ifndef MEDICINE_COMMON_H
+#define MEDICINE_COMMON_H
+
+#include <algorithm> // For upper_bound (Zipf sampling)
+#include <cctype>    // For isdigit, isupper (date validation)
+#include <cmath>     // For pow (Zipf weights)
+#include <cstdint>   // For 64-bit encoded Batch ID keys
+#include <cstdlib>   // For random number generation  (experiment mode)
+#include <random>    // For mt19937_64 (seeded benchmark datasets)
+#include <string>
+#include <string_view> // For copy-free Batch ID lookups
+#include <vector>      // For storing test data
+
+using namespace std;
+
+// ==========================================
+// 1. DATA STRUCTURES
+// ==========================================
+
+// Heap allocation counter (read by the experiment mode)
+// Counts every operator new of the calling thread; defined, together with
+// the replacement operators, in alloc_counter_main.h (included once per
+// program, by the .cpp file with main)
+extern thread_local size_t allocationCount;
+
+// These are the details for one batch of medicine
+struct Medicine {
+  string batchID;      // Key: Unique Batch ID (e.g., "B101") used for sorting
+  string medicineName; // Name of the medicine
+  int quantity;        // Physical stock count in this specific batch
+  string expiryDate;   // Safety: Expiry Date (e.g., "05-05-2026")
+  string location;     // Logistics: Exact shelf location (e.g., "Shelf A01")
+};
+
+// --- COMPACT BATCH ID KEYS ---
+// IDs shaped like <1-3 uppercase letters><digits> (e.g., "B1045") are packed
+// into one 64-bit integer that is stored inline in every node:
+//   bits 62..48: up to 3 prefix letters, 5 bits each (A = 1 ... Z = 26)
+//   bits 47..0 : the number (no leading zeros, at most 14 digits)
+// Integer order = prefix order, then numeric order, so "B9" < "B10".
+// Any other ID gets STRING_KEY, which sorts after every packed ID and falls
+// back to plain string comparison among such IDs.
+const uint64_t STRING_KEY = UINT64_MAX;
+
+inline uint64_t encodeBatchID(string_view batchID) {
+  size_t i = 0;
+  uint64_t prefix = 0;
+
+  // 1. Letter prefix (left-aligned, so "B" sorts before "BA")
+  while (i < batchID.size() && batchID[i] >= 'A' && batchID[i] <= 'Z') {
+    if (i == 3)
+      return STRING_KEY;
+    prefix = prefix * 32 + (uint64_t)(batchID[i] - 'A' + 1);
+    i++;
+  }
+  if (i == 0 || i == batchID.size())
+    return STRING_KEY;
+  for (size_t k = i; k < 3; k++) {
+    prefix *= 32;
+  }
+
+  // 2. Digits (leading zeros would make "B07" and "B7" collide)
+  size_t digits = batchID.size() - i;
+  if (digits > 14 || (batchID[i] == '0' && digits > 1))
+    return STRING_KEY;
+  uint64_t number = 0;
+  for (; i < batchID.size(); i++) {
+    if (batchID[i] < '0' || batchID[i] > '9')
+      return STRING_KEY;
+    number = number * 10 + (uint64_t)(batchID[i] - '0');
+  }
+  return (prefix << 48) | number;
+}
+
+// Validates date format (DD-MMM-YYYY), e.g., 01-JAN-2025
+// Takes a string_view, so the CSV importer can check fields in place
+inline bool isValidDate(string_view date) {
+  // 1. Basic Length Check
+  if (date.length() != 11)
+    return false;
+
+  // 2. Hyphen Check
+  if (date[2] != '-' || date[6] != '-')
+    return false;
+
+  // 3. Digit Check (Day and Year)
+  if (!isdigit(date[0]) || !isdigit(date[1]))
+    return false;
+  if (!isdigit(date[7]) || !isdigit(date[8]) || !isdigit(date[9]) ||
+      !isdigit(date[10]))
+    return false;
+
+  // 4. Uppercase Check (Structure)
+  if (!isupper(date[3]) || !isupper(date[4]) || !isupper(date[5]))
+    return false;
+
+  // 5. VALID MONTH CHECK (The missing piece!)
+  string_view monthPart = date.substr(3, 3);
+  static const string_view validMonths[] = {"JAN", "FEB", "MAR", "APR",
+                                            "MAY", "JUN", "JUL", "AUG",
+                                            "SEP", "OCT", "NOV", "DEC"};
+
+  bool isRealMonth = false;
+  for (string_view m : validMonths) {
+    if (monthPart == m) {
+      isRealMonth = true;
+      break;
+    }
+  }
+  return isRealMonth;
+}
+
+// Three-way comparison of two (key, Batch ID) pairs
+// Packed keys settle it with one integer compare; only STRING_KEY ties
+// ever touch the heap strings
+inline int compareKeys(uint64_t keyA, string_view idA, uint64_t keyB,
+                       string_view idB) {
+  if (keyA != keyB)
+    return keyA < keyB ? -1 : 1;
+  if (keyA != STRING_KEY)
+    return 0;
+  return idA.compare(idB);
+}
+
+// Generates N random medicines for the experiments
+// IDs are drawn from B0 ... B(2n - 1), so some repeat and some are gaps
+inline vector<Medicine> generateDataset(int n) {
+  vector<Medicine> dataset;
+  for (int i = 0; i < n; i++) {
+    Medicine m;
+    m.batchID = "B" + to_string(rand() % (n * 2));
+    m.medicineName = "Med " + to_string(i);
+    m.quantity = 10;
+    m.expiryDate = "01-JAN-2027";
+    m.location = "Shelf";
+    dataset.push_back(m);
+  }
+  return dataset;
+}
+
+// Generates 'count' lookups with a Zipf-shaped (hot batch) access skew
+// The r-th most popular Batch ID is asked for in proportion to 1 / r^skew;
+// with skew 0.99 and 1M batches the top 5% get about 80% of all lookups,
+// like fast movers (paracetamol, insulin) at the counter.
+// Popularity ranks are shuffled, so hot IDs are spread over the ID range
+inline vector<string> generateZipfQueries(const vector<Medicine> &dataset,
+                                          int count, double skew) {
+  vector<string> queries;
+  if (dataset.empty())
+    return queries;
+
+  // 1. Random popularity order (Fisher-Yates shuffle)
+  vector<const string *> ranked;
+  for (const auto &med : dataset) {
+    ranked.push_back(&med.batchID);
+  }
+  for (size_t i = ranked.size(); i > 1; i--) {
+    swap(ranked[i - 1], ranked[rand() % i]);
+  }
+
+  // 2. Cumulative weights: rank r has weight 1 / (r + 1)^skew
+  vector<double> cumulative(ranked.size());
+  double total = 0;
+  for (size_t r = 0; r < ranked.size(); r++) {
+    total += 1.0 / pow((double)(r + 1), skew);
+    cumulative[r] = total;
+  }
+
+  // 3. Each lookup picks a rank by binary search on a uniform draw
+  for (int i = 0; i < count; i++) {
+    double u = (double)rand() / ((double)RAND_MAX + 1) * total;
+    size_t r = upper_bound(cumulative.begin(), cumulative.end(), u) -
+               cumulative.begin();
+    if (r >= ranked.size())
+      r = ranked.size() - 1;
+    queries.push_back(*ranked[r]);
+  }
+  return queries;
+}
+
+// Order (and repetition) of the Batch IDs in a benchmark dataset
+enum KeyDistribution {
+  DIST_RANDOM,  // Uniform draws from B0 ... B(2n - 1); repeats are rejected
+  DIST_SORTED,  // B0, B1, ..., B(n - 1) (receiving dock order)
+  DIST_REVERSE, // B(n - 1), ..., B1, B0
+  DIST_ZIPF,    // Draws from B0 ... B(n - 1), skew 0.99 (hot batches repeat)
+};
+
+// Generates N medicines for the benchmark CLI from a seeded engine
+// Unlike rand(), the same seed gives the same dataset on every run and
+// program (built with the same standard library)
+inline vector<Medicine> generateBenchDataset(size_t n, KeyDistribution dist,
+                                             mt19937_64 &rng) {
+  vector<size_t> ids(n);
+  if (dist == DIST_RANDOM) {
+    uniform_int_distribution<size_t> pick(0, n * 2 - 1);
+    for (size_t i = 0; i < n; i++) {
+      ids[i] = pick(rng);
+    }
+  } else if (dist == DIST_SORTED || dist == DIST_REVERSE) {
+    for (size_t i = 0; i < n; i++) {
+      ids[i] = (dist == DIST_SORTED) ? i : n - 1 - i;
+    }
+  } else {
+    // Popularity rank r -> a shuffled ID, drawn in proportion to 1 / r^0.99
+    // (same weights as generateZipfQueries)
+    vector<size_t> ranked(n);
+    for (size_t i = 0; i < n; i++) {
+      ranked[i] = i;
+    }
+    shuffle(ranked.begin(), ranked.end(), rng);
+    vector<double> cumulative(n);
+    double total = 0;
+    for (size_t r = 0; r < n; r++) {
+      total += 1.0 / pow((double)(r + 1), 0.99);
+      cumulative[r] = total;
+    }
+    uniform_real_distribution<double> draw(0, total);
+    for (size_t i = 0; i < n; i++) {
+      size_t r = upper_bound(cumulative.begin(), cumulative.end(), draw(rng)) -
+                 cumulative.begin();
+      ids[i] = ranked[(r < n) ? r : n - 1];
+    }
+  }
+
+  vector<Medicine> dataset(n);
+  for (size_t i = 0; i < n; i++) {
+    dataset[i].batchID = "B" + to_string(ids[i]);
+    dataset[i].medicineName = "Med " + to_string(i);
+    dataset[i].quantity = 10;
+    dataset[i].expiryDate = "01-JAN-2027";
+    dataset[i].location = "Shelf";
+  }
+  return dataset;
+}
+
+#endif
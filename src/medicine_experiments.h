@@ -0,0 +1,1435 @@
+/*
+ * Name: Lau Su Hui (Abby)
+ * Matric No.: MEC245045
+ * Semester: 20252026-1
+ * Course: MECS1023 ADSA
+ * Group & Theme: Group 1-Pharmacy Inventory Control System
+ * Assignment Title: Medicine Management System (Experiment Mode)
+ */
+
+#ifndef MEDICINE_EXPERIMENTS_H
+#define MEDICINE_EXPERIMENTS_H
+
+#include <chrono>  // For timing each phase
+#include <fstream> // For writing results to file
+#include <initializer_list>
+#include <iomanip> // For table formatting (setw)
+#include <iostream>
+#include <ratio>   // For nano, micro, milli (phase time units)
+#include <sstream> // For the getline import baseline (CSV experiment)
+#include <string>
+#include <thread>        // For hardware_concurrency (parallel experiments)
+#include <unordered_set> // For the repeated IDs of a benchmark dataset
+#include <vector>
+
+#include "medicine_common.h"
+#include "medicine_manager.h"
+#include "mixed_workload.h"
+
+// ==========================================
+// 1. PHASE TIMING & RESULT TABLES
+// ==========================================
+
+// Runs one phase of an experiment (e.g., every insert) and returns its
+// wall-clock time in Unit: nano, micro, milli or ratio<1> (seconds)
+template <class Unit, class Phase> double timePhase(Phase phase) {
+  auto start = high_resolution_clock::now();
+  phase();
+  auto stop = high_resolution_clock::now();
+  return duration<double, Unit>(stop - start).count();
+}
+
+// One column of an ExperimentTable
+struct TableColumn {
+  string heading;     // Console heading
+  int width;          // Console width (0 = last column, no padding)
+  const char *metric; // Name in the results file (nullptr = console only)
+};
+
+// A results table: each row is printed under the headings and written to
+// the experiment's results file as "<row> <metric>: <value>", one line
+// per column that has a metric
+class ExperimentTable {
+private:
+  ostream &file;
+  vector<TableColumn> columns; // columns[0] holds the row labels
+
+public:
+  // Prints the heading line
+  ExperimentTable(ostream &resultsFile, initializer_list<TableColumn> list)
+      : file(resultsFile), columns(list) {
+    for (const TableColumn &column : columns) {
+      cout << left << setw(column.width) << column.heading;
+    }
+    cout << endl;
+  }
+
+  // One row: the label, then one value per remaining column
+  template <class... Values>
+  void row(const string &label, const Values &...values) {
+    static_assert(sizeof...(Values) > 0, "a row needs values");
+    cout << left << setw(columns[0].width) << label;
+    size_t c = 1;
+    auto cell = [&](const auto &value) {
+      const TableColumn &column = columns[c++];
+      cout << setw(column.width) << value;
+      if (column.metric != nullptr)
+        file << label << " " << column.metric << ": " << value << endl;
+    };
+    (cell(values), ...);
+    cout << endl;
+  }
+};
+
+// ==========================================
+// 2. EXPERIMENT MODE (MEDICINE MANAGER)
+// ==========================================
+
+// --- EXPERIMENT MODE ---
+// This function populates random data to create the Analysis Report
+template <class Engine>
+void MedicineManager<Engine>::runExperiment(int n) {
+  // 1. Clear existing data to ensure fair test
+  resetTree();
+
+  cout << "\nCreating " << n << " random medicines..." << endl;
+
+  // 2. Generate N random data or medicines
+  vector<Medicine> dataset = generateDataset(n);
+
+  // 3. Measure Insertion Time (Average)
+  // Repeated IDs are rejected, so the added batches are counted apart
+  size_t added = 0;
+  double insUs = timePhase<micro>([&] {
+    for (auto &med : dataset) {
+      added += addMedicine(med, false); // To suppress duplicate messages
+    }
+  });
+
+  // 4. Measure Search Time (Average)
+  // Hits are counted so an optimising compiler cannot drop the searches
+  size_t hits = 0;
+  double searchUs = timePhase<micro>([&] {
+    for (auto &med : dataset) {
+      if (findMedicine(med.batchID) != nullptr)
+        hits++;
+    }
+  });
+
+  // 5. Measure Search Time under hot-batch skew (Zipf, skew 0.99)
+  // Same number of lookups, but a few fast movers get most of them
+  vector<string> hotQueries = generateZipfQueries(dataset, n, 0.99);
+  size_t hotHits = 0;
+  double hotUs = timePhase<micro>([&] {
+    for (auto &id : hotQueries) {
+      if (findMedicine(id) != nullptr)
+        hotHits++;
+    }
+  });
+  auto height = engine.height();
+
+  // 6. Latency Distribution: the same operations again, each timed on
+  // its own, since an average hides the slow ones (deep paths, rotation
+  // cascades); ends with every batch deleted
+  resetTree();
+  latency = OperationLatency();
+  setLatencyTracking(true);
+  for (auto &med : dataset) {
+    addMedicine(med, false);
+  }
+  for (auto &med : dataset) {
+    findMedicine(med.batchID);
+  }
+  for (int pass = 0; pass < 5; pass++) {
+    forEachMedicine([](const Medicine &) {});
+  }
+  for (auto &med : dataset) {
+    removeMedicine(med.batchID);
+  }
+  setLatencyTracking(false);
+
+  // 7. Print Analysis Report
+  ofstream outFile(Engine::RESULTS_FILE);
+  outFile << "Avg Insert Time: " << insUs / n << endl;
+  outFile << "Avg Search Time: " << searchUs / n << endl;
+  outFile << "Avg Zipf Search Time: " << hotUs / n << endl;
+  outFile << "Tree Height: " << height << endl;
+  writeLatencyReport(outFile);
+  outFile.close();
+
+  cout << "\n--- " << Engine::NAME << " Analysis Report Data (Size: " << n
+       << ") ---" << endl;
+  cout << "Avg Insert Time: " << insUs / n << " microseconds" << endl;
+  cout << "Avg Search Time: " << searchUs / n << " microseconds" << endl;
+  cout << "Avg Zipf Search Time: " << hotUs / n
+       << " microseconds (hot batches)" << endl;
+  cout << "Total Time: " << insUs << " (Insert) / " << searchUs
+       << " (Search) / " << hotUs << " (Zipf)" << endl;
+  cout << "Batches Added: " << added << " / " << n
+       << " (the rest were duplicate IDs)" << endl;
+  cout << "Batches Found: " << hits << " / " << n << " (Zipf: " << hotHits
+       << " / " << n << ")" << endl;
+  cout << "Tree Height: " << height << " levels" << endl;
+  cout << "\nPer-Operation Latency (one operation timed at a time):" << endl;
+  writeLatencyReport(cout);
+}
+
+// --- EXPERIMENT: NODE POOL VS HEAP ALLOCATION ---
+// Runs the same insert/search/clear workload with the pool on and off
+template <class Engine>
+void MedicineManager<Engine>::runPoolExperiment(int n) {
+  cout << "\nCreating " << n << " random medicines..." << endl;
+  vector<Medicine> dataset = generateDataset(n);
+
+  ofstream outFile(Engine::RESULTS_FILE);
+  cout << "\n--- " << Engine::NAME << " Node Pool vs Heap (Size: " << n
+       << ") ---" << endl;
+  ExperimentTable table(outFile, {{"Allocator", 12, nullptr},
+                                  {"Avg Insert (us)", 22, "Avg Insert Time"},
+                                  {"Avg Search (us)", 22, "Avg Search Time"},
+                                  {"Clear Tree (us)", 20, "Clear Tree Time"},
+                                  {"Hits", 0, nullptr}});
+
+  bool modes[2] = {true, false}; // Pool first, then heap
+  for (bool pooled : modes) {
+    setPoolEnabled(pooled);
+
+    // 1. Insertion
+    double insUs = timePhase<micro>([&] {
+      for (auto &med : dataset) {
+        addMedicine(med, false);
+      }
+    });
+
+    // 2. Search (hits are counted so the lookups cannot be optimised out)
+    size_t hits = 0;
+    double searchUs = timePhase<micro>([&] {
+      for (auto &med : dataset) {
+        hits += findMedicine(med.batchID) != nullptr;
+      }
+    });
+
+    // 3. Teardown of the whole tree
+    double clearUs = timePhase<micro>([this] { resetTree(); });
+
+    table.row(pooled ? "Node Pool" : "Heap", insUs / n, searchUs / n,
+              clearUs, hits);
+  }
+  setPoolEnabled(true); // Back to the default allocator
+  outFile.close();
+}
+
+// --- EXPERIMENT: HEAP ALLOCATIONS PER OPERATION ---
+// Counts operator new calls per insert/search/delete, using realistic
+// record sizes (names and locations longer than the small-string buffer)
+template <class Engine>
+void MedicineManager<Engine>::runAllocationExperiment(int n) {
+  resetTree();
+  cout << "\nCreating " << n << " random medicines..." << endl;
+  vector<Medicine> dataset = generateDataset(n);
+  for (auto &med : dataset) {
+    med.medicineName = "Paracetamol 500mg Tablet (" + med.medicineName + ")";
+    med.location = "Pharmacy Store Room, Shelf A01";
+  }
+
+  // 1. Copy-in insertion: the dataset keeps its records
+  size_t before = allocationCount;
+  for (const auto &med : dataset) {
+    addMedicine(med, false);
+  }
+  double copyIns = (double)(allocationCount - before) / n;
+
+  // 2. Search (string_view keys: no temporary strings)
+  before = allocationCount;
+  for (const auto &med : dataset) {
+    findMedicine(med.batchID);
+  }
+  double search = (double)(allocationCount - before) / n;
+
+  // 3. Deletion (nodes are relinked, records never copied)
+  before = allocationCount;
+  for (const auto &med : dataset) {
+    removeMedicine(med.batchID);
+  }
+  double remove = (double)(allocationCount - before) / n;
+
+  // 4. Move-in insertion on a fresh heap-allocated tree
+  setPoolEnabled(false);
+  before = allocationCount;
+  for (auto &med : dataset) {
+    addMedicine(std::move(med), false);
+  }
+  double moveIns = (double)(allocationCount - before) / n;
+  setPoolEnabled(true);
+
+  // 5. Print Analysis Report
+  ofstream outFile(Engine::RESULTS_FILE);
+  outFile << "Allocations per Insert (copy-in): " << copyIns << endl;
+  outFile << "Allocations per Insert (move-in, heap nodes): " << moveIns
+          << endl;
+  outFile << "Allocations per Search: " << search << endl;
+  outFile << "Allocations per Delete: " << remove << endl;
+  outFile.close();
+
+  cout << "\n--- " << Engine::NAME << " Allocations per Operation (Size: "
+       << n << ") ---" << endl;
+  cout << "Insert (copy-in):             " << copyIns << endl;
+  cout << "Insert (move-in, heap nodes): " << moveIns << endl;
+  cout << "Search:                       " << search << endl;
+  cout << "Delete:                       " << remove << endl;
+}
+
+// --- EXPERIMENT: PACKED INTEGER KEYS VS STRING KEYS ---
+// Runs the same insert/search workload with both key modes
+template <class Engine>
+void MedicineManager<Engine>::runKeyEncodingExperiment(int n) {
+  cout << "\nCreating " << n << " random medicines..." << endl;
+  vector<Medicine> dataset = generateDataset(n);
+
+  ofstream outFile(Engine::RESULTS_FILE);
+  cout << "\n--- " << Engine::NAME << " Packed Keys vs String Keys (Size: "
+       << n << ") ---" << endl;
+  ExperimentTable table(outFile,
+                        {{"Key Mode", 14, nullptr},
+                         {"Avg Insert (ns)", 22, "Keys Avg Insert Time"},
+                         {"Avg Search (ns)", 22, "Keys Avg Search Time"},
+                         {"Hits", 0, nullptr}});
+
+  bool modes[2] = {true, false}; // Packed keys first, then strings
+  for (bool packed : modes) {
+    setKeyEncoding(packed);
+
+    double insNs = timePhase<nano>([&] {
+      for (auto &med : dataset) {
+        addMedicine(med, false);
+      }
+    });
+
+    // Hits are counted so the optimiser cannot drop the lookups
+    size_t hits = 0;
+    double searchNs = timePhase<nano>([&] {
+      for (auto &med : dataset) {
+        hits += findMedicine(med.batchID) != nullptr;
+      }
+    });
+
+    table.row(packed ? "Packed" : "String", insNs / n, searchNs / n, hits);
+  }
+  setKeyEncoding(true); // Back to the default key mode
+  outFile.close();
+}
+
+// --- EXPERIMENT: BULK LOAD VS INCREMENTAL INSERTS ---
+// Loads sizes 10^4, 10^5, ... up to maxN both ways and times each build
+template <class Engine>
+void MedicineManager<Engine>::runBulkLoadExperiment(int maxN) {
+  ofstream outFile(Engine::RESULTS_FILE);
+  cout << "\n--- " << Engine::NAME << " Bulk Load vs Incremental Inserts ---"
+       << endl;
+  ExperimentTable table(
+      outFile, {{"Size", 12, nullptr},
+                {"Incremental (ms)", 24, "Incremental Load Time (ms)"},
+                {"Bulk Load (ms)", 20, "Bulk Load Time (ms)"},
+                {"Batches Stored", 0, nullptr}});
+
+  for (long long n = 10000; n <= maxN; n *= 10) {
+    vector<Medicine> dataset = generateDataset((int)n);
+    vector<Medicine> copy = dataset;
+
+    // 1. Incremental: one addMedicine (search + insert) per batch
+    resetTree();
+    double incMs = timePhase<milli>([&] {
+      for (auto &med : dataset) {
+        addMedicine(std::move(med), false);
+      }
+    });
+    dataset.clear();
+
+    // 2. Bulk: sort, de-duplicate and build in one pass
+    resetTree();
+    size_t stored = 0;
+    double bulkMs =
+        timePhase<milli>([&] { stored = bulkLoad(std::move(copy)); });
+
+    table.row(to_string(n), incMs, bulkMs, stored);
+  }
+  outFile.close();
+  resetTree();
+}
+
+// --- EXPERIMENT: PARALLEL BULK BUILD VS THREAD COUNT ---
+// Bulk loads the same N batches into an empty tree with 1, 2, 4, ...
+// threads and finally every core (e.g., a 10M-batch warehouse import)
+template <class Engine>
+void MedicineManager<Engine>::runParallelBuildExperiment(int n) {
+  int cores = (int)thread::hardware_concurrency();
+  if (cores < 1)
+    cores = 1;
+  vector<int> threadCounts;
+  for (int t = 1; t < cores; t *= 2) {
+    threadCounts.push_back(t);
+  }
+  threadCounts.push_back(cores);
+
+  cout << "\nCreating " << n << " random medicines..." << endl;
+  vector<Medicine> dataset = generateDataset(n);
+
+  ofstream outFile(Engine::RESULTS_FILE);
+  cout << "\n--- " << Engine::NAME << " Parallel Bulk Build (Size: " << n
+       << ", " << cores << " cores) ---" << endl;
+  ExperimentTable table(
+      outFile, {{"Threads", 10, nullptr},
+                {"Build (ms)", 16, "Threads Bulk Build Time (ms)"},
+                {"Speedup", 12, nullptr},
+                {"Batches Stored", 18, nullptr},
+                {"Tree Height", 0, nullptr}});
+
+  double baseMs = 0;
+  for (int threads : threadCounts) {
+    vector<Medicine> copy = dataset;
+    resetTree();
+    size_t stored = 0;
+    double ms =
+        timePhase<milli>([&] { stored = bulkLoad(std::move(copy), threads); });
+    if (threads == 1)
+      baseMs = ms;
+    table.row(to_string(threads), ms, (ms > 0 ? baseMs / ms : 0), stored,
+              engine.height());
+  }
+  outFile.close();
+  resetTree();
+}
+
+// --- EXPERIMENT: PARALLEL STOCK REPORTS VS SINGLE THREAD ---
+// Builds the three stock reports over N batches (500 medicine names,
+// 200 shelves, 36 expiry months) with 1, 2, 4, ... threads and every core
+template <class Engine>
+void MedicineManager<Engine>::runAggregationExperiment(int n) {
+  int cores = (int)thread::hardware_concurrency();
+  if (cores < 1)
+    cores = 1;
+  vector<int> threadCounts;
+  for (int t = 1; t < cores; t *= 2) {
+    threadCounts.push_back(t);
+  }
+  threadCounts.push_back(cores);
+
+  static const char *MONTHS[12] = {"JAN", "FEB", "MAR", "APR",
+                                   "MAY", "JUN", "JUL", "AUG",
+                                   "SEP", "OCT", "NOV", "DEC"};
+  cout << "\nCreating " << n << " random medicines..." << endl;
+  vector<Medicine> dataset = generateDataset(n);
+  for (auto &med : dataset) {
+    med.medicineName = "Med " + to_string(rand() % 500);
+    med.quantity = 1 + rand() % 100;
+    med.expiryDate = "01-" + string(MONTHS[rand() % 12]) + "-" +
+                     to_string(2026 + rand() % 3);
+    med.location = "Shelf " + to_string(rand() % 200);
+  }
+  resetTree();
+  size_t stored = bulkLoad(std::move(dataset));
+
+  ofstream outFile(Engine::RESULTS_FILE);
+  cout << "\n--- " << Engine::NAME << " Parallel Stock Reports (Size: "
+       << stored << ", " << cores << " cores) ---" << endl;
+  ExperimentTable table(
+      outFile, {{"Threads", 10, nullptr},
+                {"Units/Med (ms)", 18, nullptr},
+                {"Per Shelf (ms)", 18, nullptr},
+                {"Per Month (ms)", 18, nullptr},
+                {"Total (ms)", 14, "Threads Stock Reports Time (ms)"},
+                {"Speedup", 0, nullptr}});
+
+  double baseMs = 0;
+  long long totalUnits = 0;
+  for (int threads : threadCounts) {
+    map<string, long long> units;
+    double unitsMs =
+        timePhase<milli>([&] { units = unitsPerMedicine(threads); });
+    double shelfMs = timePhase<milli>([&] { batchesPerLocation(threads); });
+    double monthMs = timePhase<milli>([&] { expiringPerMonth(threads); });
+    double ms = unitsMs + shelfMs + monthMs;
+    if (threads == 1) {
+      baseMs = ms;
+      totalUnits = 0;
+      for (auto &entry : units) {
+        totalUnits += entry.second;
+      }
+    }
+    table.row(to_string(threads), unitsMs, shelfMs, monthMs, ms,
+              (ms > 0 ? baseMs / ms : 0));
+  }
+  cout << "(" << totalUnits << " units in stock)" << endl;
+  outFile.close();
+  resetTree();
+}
+
+// --- EXPERIMENT: SNAPSHOT FILE VS RE-INSERTING EVERY BATCH ---
+// Saves N batches to a snapshot, then restores them three ways: mapped
+// and bulk loaded on one thread and on every core, and one addMedicine
+// call per batch (how the inventory was rebuilt before snapshots)
+template <class Engine>
+void MedicineManager<Engine>::runSnapshotExperiment(int n) {
+  const string path = "snapshot_experiment.snap";
+  int cores = (int)thread::hardware_concurrency();
+  if (cores < 1)
+    cores = 1;
+
+  cout << "\nCreating " << n << " random medicines..." << endl;
+  resetTree();
+  vector<Medicine> dataset = generateDataset(n);
+  bulkLoad(std::move(dataset));
+
+  // 1. Save
+  long long saved = 0;
+  double saveMs = timePhase<milli>([&] { saved = saveSnapshot(path); });
+  if (saved < 0) {
+    cout << "Could not write " << path << ".❌" << endl;
+    resetTree();
+    return;
+  }
+  size_t fileBytes = 0;
+  {
+    MappedFile file;
+    if (file.open(path))
+      fileBytes = file.size();
+  }
+
+  // 2. Load (mmap + checks + bulk build), one thread and every core
+  long long loaded = 0;
+  double load1Ms = timePhase<milli>([&] { loaded = loadSnapshot(path, 1); });
+  double loadNMs = timePhase<milli>([&] { loadSnapshot(path, cores); });
+
+  // 3. Rebuild one batch at a time from the same records
+  vector<Medicine> records;
+  engine.forEach([&records](const Medicine &med) { records.push_back(med); });
+  resetTree();
+  double addMs = timePhase<milli>([&] {
+    for (auto &med : records) {
+      addMedicine(std::move(med), false);
+    }
+  });
+  remove(path.c_str());
+
+  // 4. Print Analysis Report
+  ofstream outFile(Engine::RESULTS_FILE);
+  outFile << "Snapshot Save Time (ms): " << saveMs << endl;
+  outFile << "Snapshot Load Time, 1 Thread (ms): " << load1Ms << endl;
+  outFile << "Snapshot Load Time, " << cores << " Threads (ms): " << loadNMs
+          << endl;
+  outFile << "One-by-One Insert Time (ms): " << addMs << endl;
+  outFile.close();
+
+  cout << "\n--- " << Engine::NAME << " Snapshot File (Size: " << loaded
+       << " batches, " << fileBytes / 1024 << " KB) ---" << endl;
+  string loadN = "Load (" + to_string(cores) + " threads):";
+  cout << left << setw(24) << "Save:" << saveMs << " ms" << endl;
+  cout << left << setw(24) << "Load (1 thread):" << load1Ms << " ms" << endl;
+  cout << left << setw(24) << loadN << loadNMs << " ms" << endl;
+  cout << left << setw(24) << "addMedicine per batch:" << addMs << " ms"
+       << endl;
+  resetTree();
+}
+
+// --- EXPERIMENT: WRITE-AHEAD LOG, FSYNC PER CHANGE VS GROUP COMMIT ---
+// Runs the same adds and deletes (3 : 1) with the log syncing after
+// every change and after groups of 16, 256 and 4096 changes (or 10 ms),
+// then times replaying the log and compacting it into a snapshot
+template <class Engine>
+void MedicineManager<Engine>::runLogExperiment(int n) {
+  const string logPath = "wal_experiment.log";
+  const string snapPath = "wal_experiment.snap";
+  // fsync per change can take milliseconds each, so N is capped
+  int ops = (n < 20000) ? n : 20000;
+
+  cout << "\nCreating " << ops << " random changes..." << endl;
+  vector<Medicine> dataset = generateDataset(ops);
+  vector<string> removals;
+  for (int i = 0; i < ops / 3; i++) {
+    removals.push_back(dataset[rand() % ops].batchID);
+  }
+
+  struct Policy {
+    const char *label;
+    size_t groupSize;
+    int groupMs;
+  };
+  const Policy policies[] = {{"fsync per change", 1, 0},
+                             {"Group of 16", 16, 10},
+                             {"Group of 256", 256, 10},
+                             {"Group of 4096", 4096, 10}};
+
+  ofstream outFile(Engine::RESULTS_FILE);
+  cout << "\n--- " << Engine::NAME << " Write-Ahead Log (" << ops
+       << " adds + " << removals.size() << " deletes) ---" << endl;
+  ExperimentTable table(outFile, {{"Commit Policy", 20, nullptr},
+                                  {"Changes/sec", 16, "(changes/sec)"},
+                                  {"fsyncs", 10, nullptr},
+                                  {"Log (KB)", 0, nullptr}});
+
+  for (const Policy &policy : policies) {
+    closeLog();
+    resetTree();
+    remove(logPath.c_str());
+    openLog(logPath, policy.groupSize, policy.groupMs);
+    size_t changes = 0;
+    double seconds = timePhase<ratio<1>>([&] {
+      for (size_t i = 0; i < dataset.size(); i++) {
+        changes += addMedicine(dataset[i], false);
+        if (i % 3 == 2 && removeMedicine(removals[i / 3]))
+          changes++;
+      }
+      syncLog();
+    });
+    size_t logBytes = 0;
+    {
+      MappedFile file;
+      if (file.open(logPath))
+        logBytes = file.size();
+    }
+    double rate = (seconds > 0) ? changes / seconds : 0;
+    table.row(policy.label, (long long)rate, logSyncCount(), logBytes / 1024);
+    closeLog();
+  }
+
+  // Replay: rebuild the inventory from the last log alone
+  resetTree();
+  long long replayed = 0;
+  double replayMs = timePhase<milli>([&] { replayed = openLog(logPath); });
+
+  // Compaction: snapshot the inventory and empty the log
+  long long saved = 0;
+  double compactMs = timePhase<milli>([&] { saved = compact(snapPath); });
+  closeLog();
+
+  cout << "Replay:     " << replayMs << " ms (" << replayed
+       << " logged changes)" << endl;
+  cout << "Compaction: " << compactMs << " ms (" << saved
+       << " batches into a snapshot, log emptied)" << endl;
+  outFile << "Log Replay Time (ms): " << replayMs << endl;
+  outFile << "Log Compaction Time (ms): " << compactMs << endl;
+  outFile.close();
+  remove(logPath.c_str());
+  remove(snapPath.c_str());
+  resetTree();
+}
+
+// --- EXPERIMENT: STREAMING CSV IMPORT VS LINE-BY-LINE PARSING ---
+// Writes a supplier file of N rows (about 1% invalid, some quoted names
+// with commas), then imports it into an empty system (bulk path), into
+// a system already holding N other batches (one insert per row), and
+// the old way: getline per row, one string per field, addMedicine
+template <class Engine>
+void MedicineManager<Engine>::runCsvImportExperiment(int n) {
+  const string path = "csv_experiment.csv";
+
+  // 1. Write the stock file (faults cycle through the four checks)
+  cout << "\nWriting " << n << " CSV rows..." << endl;
+  vector<Medicine> dataset = generateDataset(n);
+  {
+    ofstream out(path, ios::binary);
+    out << "Batch ID,Medicine Name,Quantity,Expiry Date,Location\n";
+    for (int i = 0; i < n; i++) {
+      const Medicine &med = dataset[i];
+      string name = med.medicineName;
+      if (i % 10 == 0)
+        name = "\"" + name + ", 500mg\""; // Quoted comma
+      if (i % 100 == 99) {
+        switch ((i / 100) % 4) {
+        case 0:
+          out << med.batchID << "," << name << ",ten," << med.expiryDate
+              << "," << med.location << "\n";
+          break;
+        case 1:
+          out << med.batchID << "," << name << "," << med.quantity
+              << ",2027-01-01," << med.location << "\n";
+          break;
+        case 2:
+          out << med.batchID << "," << name << "," << med.quantity << "\n";
+          break;
+        default:
+          out << "," << name << "," << med.quantity << ","
+              << med.expiryDate << "," << med.location << "\n";
+        }
+        continue;
+      }
+      out << med.batchID << "," << name << "," << med.quantity << ","
+          << med.expiryDate << "," << med.location << "\n";
+    }
+  }
+
+  // 2. Streaming import into an empty system (bulk load)
+  resetTree();
+  ImportReport intoEmpty = importCsv(path, false);
+
+  // 3. Streaming import on top of N stored batches (row inserts)
+  resetTree();
+  bulkLoad(generateDataset(n));
+  ImportReport intoStored = importCsv(path, false);
+
+  // 4. Baseline: getline + stringstream, a string per field
+  resetTree();
+  ImportReport baseline = {true, 0, 0, 0, 0, true, 0.0};
+  baseline.seconds = timePhase<ratio<1>>([&] {
+    ifstream in(path);
+    string line, field;
+    getline(in, line); // Header
+    while (getline(in, line)) {
+      vector<string> fields;
+      stringstream row(line);
+      while (getline(row, field, ',')) {
+        fields.push_back(field);
+      }
+      baseline.rows++;
+      int quantity = 0;
+      bool ok = fields.size() == 5 && !fields[0].empty() &&
+                !fields[1].empty() && !fields[4].empty() &&
+                isValidDate(fields[3]);
+      if (ok) {
+        const string &q = fields[2];
+        auto parsed = from_chars(q.data(), q.data() + q.size(), quantity);
+        ok = parsed.ec == errc() && parsed.ptr == q.data() + q.size() &&
+             quantity >= 0;
+      }
+      if (!ok) {
+        baseline.rejected++;
+      } else if (addMedicine(Medicine{fields[0], fields[1], quantity,
+                                      fields[3], fields[4]},
+                             false)) {
+        baseline.imported++;
+      } else {
+        baseline.duplicates++;
+      }
+    }
+  });
+  remove(path.c_str());
+
+  // 5. Print Analysis Report
+  // (the baseline splits quoted names at their comma, so it rejects
+  // every quoted row as well)
+  ofstream outFile(Engine::RESULTS_FILE);
+  cout << "\n--- " << Engine::NAME << " CSV Import (" << n
+       << " rows) ---" << endl;
+  ExperimentTable table(outFile, {{"Import", 26, nullptr},
+                                  {"Rows/sec", 14, "(rows/sec)"},
+                                  {"Added", 10, nullptr},
+                                  {"Rejected", 10, "Rejected Rows"},
+                                  {"Duplicates", 0, nullptr}});
+  const pair<const char *, ImportReport *> runs[] = {
+      {"Streaming, empty (bulk)", &intoEmpty},
+      {"Streaming, non-empty", &intoStored},
+      {"getline + stringstream", &baseline}};
+  for (const auto &run : runs) {
+    const ImportReport &r = *run.second;
+    double rate = (r.seconds > 0) ? r.rows / r.seconds : 0;
+    table.row(run.first, (long long)rate, r.imported, r.rejected,
+              r.duplicates);
+  }
+  outFile.close();
+  resetTree();
+}
+
+// --- EXPERIMENT: BUFFERED EXPORT VS PER-ROW ENDL ---
+// Lists N batches into a file the old way (setw + endl: one flush per
+// batch) and through ExportWriter as a table, CSV and JSON lines
+// (a file instead of the console, so only the writing is timed)
+template <class Engine>
+void MedicineManager<Engine>::runExportExperiment(int n) {
+  const string path = "export_experiment.txt";
+  cout << "\nCreating " << n << " random medicines..." << endl;
+  resetTree();
+  bulkLoad(generateDataset(n));
+
+  auto fileKB = [&path]() {
+    MappedFile file;
+    return file.open(path) ? file.size() / 1024 : 0;
+  };
+
+  // 1. Old listing: iostream manipulators and endl on every row
+  double oldMs = timePhase<milli>([&] {
+    ofstream out(path);
+    out << left << setw(15) << "Batch ID" << setw(25) << "Name" << setw(10)
+        << "Quantity" << setw(15) << "Expiry" << setw(20) << "Location"
+        << endl;
+    out << string(85, '-') << endl;
+    engine.forEach([&out](const Medicine &med) {
+      out << left << setw(15) << med.batchID << setw(25) << med.medicineName
+          << setw(10) << med.quantity << setw(15) << med.expiryDate
+          << setw(15) << med.location << endl;
+    });
+  });
+  size_t oldKB = fileKB();
+
+  // 2. Buffered export in each format
+  const pair<const char *, ExportFormat> formats[] = {
+      {"Buffered table", EXPORT_TABLE},
+      {"Buffered CSV", EXPORT_CSV},
+      {"Buffered JSON lines", EXPORT_JSON_LINES}};
+
+  ofstream outFile(Engine::RESULTS_FILE);
+  cout << "\n--- " << Engine::NAME << " Export (Size: " << n << ") ---"
+       << endl;
+  ExperimentTable table(outFile, {{"Writer", 24, nullptr},
+                                  {"Time (ms)", 14, "Export Time (ms)"},
+                                  {"MB/sec", 14, nullptr},
+                                  {"File (KB)", 0, nullptr}});
+  auto report = [&table](const char *label, double timeMs, size_t kb) {
+    double rate = (timeMs > 0) ? kb / 1024.0 / (timeMs / 1000) : 0;
+    table.row(label, timeMs, rate, kb);
+  };
+  report("setw + endl per row", oldMs, oldKB);
+  for (const auto &format : formats) {
+    double ms = timePhase<milli>([&] { exportMedicines(path, format.second); });
+    report(format.first, ms, fileKB());
+  }
+  outFile.close();
+  remove(path.c_str());
+  resetTree();
+}
+
+// --- EXPERIMENT: SORTED BATCH IDS (RECEIVING DOCK ORDER) ---
+// Inserts B1, B2, B3, ... in order, then searches, traverses and deletes
+// them all. A plain BST degrades into an n-deep chain (walked by the
+// iterative operations without touching the call stack); the balanced
+// engines pay for it with a rotation cascade on almost every insert
+template <class Engine>
+void MedicineManager<Engine>::runSortedInputExperiment(int n) {
+  resetTree();
+  cout << "\nInserting " << n << " sequential Batch IDs (B1, B2, ...)..."
+       << endl;
+
+  // 1. Insertion in ascending ID order
+  double insMs = timePhase<milli>([&] {
+    for (int i = 1; i <= n; i++) {
+      emplaceMedicine("B" + to_string(i), "Med " + to_string(i), 10,
+                      "01-JAN-2027", "Shelf", false);
+    }
+  });
+
+  // 2. Search a sample of up to 1000 evenly spaced IDs (deepest included)
+  int step = (n > 1000) ? n / 1000 : 1;
+  size_t searches = 0;
+  size_t hits = 0;
+  double searchUs = timePhase<micro>([&] {
+    for (int i = n; i >= 1; i -= step) {
+      hits += findMedicine("B" + to_string(i)) != nullptr;
+      searches++;
+    }
+  });
+  searchUs /= (searches > 0 ? searches : 1);
+
+  // 3. Full in-order traversal
+  size_t visited = 0;
+  double travMs = timePhase<milli>([&] {
+    engine.forEach([&visited](const Medicine &) { visited++; });
+  });
+
+  // 4. Delete every batch
+  size_t removed = 0;
+  double delMs = timePhase<milli>([&] {
+    for (int i = 1; i <= n; i++) {
+      removed += removeMedicine("B" + to_string(i));
+    }
+  });
+
+  // 5. Print Analysis Report
+  ofstream outFile(Engine::RESULTS_FILE);
+  outFile << "Sorted Input Insert Time (ms): " << insMs << endl;
+  outFile << "Sorted Input Avg Search Time (us): " << searchUs << endl;
+  outFile << "Sorted Input Traversal Time (ms): " << travMs << endl;
+  outFile << "Sorted Input Delete Time (ms): " << delMs << endl;
+  outFile.close();
+
+  cout << "\n--- " << Engine::NAME << " Sorted Input Report (Size: " << n
+       << ") ---" << endl;
+  cout << "Insert:    " << insMs << " ms" << endl;
+  cout << "Search:    " << searchUs << " us per search (" << hits << " of "
+       << searches << " sampled IDs found)" << endl;
+  cout << "Traversal: " << travMs << " ms (" << visited
+       << " batches in order)" << endl;
+  cout << "Delete:    " << delMs << " ms (" << removed << " removed)" << endl;
+}
+
+// --- EXPERIMENT: TREE SHAPE & WORK COUNTERS ---
+// Explains the timings of the other reports with counts instead of time:
+// random and sequential (B1, B2, ...) Batch IDs go into the Counting
+// version of this engine, which reports the shape of the tree and the
+// comparisons, nodes visited and rotations per insert, search and delete
+template <class Engine>
+void MedicineManager<Engine>::runTreeShapeExperiment(int n) {
+  ofstream outFile(Engine::RESULTS_FILE);
+  cout << "\n--- " << Engine::NAME << " Tree Shape & Work (Size: " << n
+       << ") ---" << endl;
+
+  for (int sorted = 0; sorted < 2; sorted++) {
+    const char *order = sorted ? "Sorted" : "Random";
+    vector<Medicine> dataset = generateDataset(n);
+    if (sorted) {
+      for (int i = 0; i < n; i++) {
+        dataset[i].batchID = "B" + to_string(i + 1);
+      }
+    }
+    // Up to 1000 evenly spaced searches (a sorted BST is an n-deep chain)
+    int step = (n > 1000) ? n / 1000 : 1;
+    MedicineManager<typename Engine::Counting> probe;
+
+    // 1. Inserts, then the shape they left behind
+    probe.resetWorkCounts();
+    for (const Medicine &med : dataset) {
+      probe.addMedicine(med, false);
+    }
+    WorkCounts insertWork = probe.workCounts();
+    TreeStats shape = probe.treeStats();
+
+    // 2. Searches
+    probe.resetWorkCounts();
+    size_t searches = 0;
+    for (int i = 0; i < n; i += step) {
+      probe.findMedicine(dataset[i].batchID);
+      searches++;
+    }
+    WorkCounts searchWork = probe.workCounts();
+
+    // 3. Deletes (repeated random IDs miss, like the Standard Report)
+    probe.resetWorkCounts();
+    for (const Medicine &med : dataset) {
+      probe.removeMedicine(med.batchID);
+    }
+    WorkCounts deleteWork = probe.workCounts();
+
+    // 4. Print Analysis Report
+    // Height counts levels; the deepest node sits one level above it
+    // (an empty tree has height 0 and no deepest node)
+    cout << "\n" << order << " Batch IDs: " << shape.nodes
+         << " batches, height " << shape.height;
+    if (shape.nodes > 0) {
+      cout << " (deepest node at depth " << shape.height - 1
+           << "), average depth " << shape.averageDepth;
+    }
+    cout << endl;
+    outFile << order << " Input Height: " << shape.height << endl;
+    outFile << order << " Input Avg Depth: " << shape.averageDepth << endl;
+
+    cout << left << setw(10) << "Phase" << setw(12) << "Cmp/op"
+         << setw(12) << "Visits/op" << setw(10) << "LL" << setw(10) << "RR"
+         << setw(10) << "LR" << "RL" << endl;
+    auto row = [&](const char *phase, const WorkCounts &work, size_t ops) {
+      double perOp = (ops > 0) ? (double)ops : 1;
+      cout << left << setw(10) << phase << setw(12)
+           << work.comparisons / perOp << setw(12)
+           << work.nodesVisited / perOp << setw(10)
+           << work.rotations[ROTATE_LL] << setw(10)
+           << work.rotations[ROTATE_RR] << setw(10)
+           << work.rotations[ROTATE_LR] << work.rotations[ROTATE_RL]
+           << endl;
+      outFile << order << " " << phase
+              << " Comparisons per Op: " << work.comparisons / perOp
+              << endl;
+      outFile << order << " " << phase
+              << " Nodes Visited per Op: " << work.nodesVisited / perOp
+              << endl;
+      outFile << order << " " << phase << " Rotations (LL/RR/LR/RL): "
+              << work.rotations[ROTATE_LL] << "/"
+              << work.rotations[ROTATE_RR] << "/"
+              << work.rotations[ROTATE_LR] << "/"
+              << work.rotations[ROTATE_RL] << endl;
+    };
+    row("Insert", insertWork, dataset.size());
+    row("Search", searchWork, searches);
+    row("Delete", deleteWork, dataset.size());
+
+    // Depth histogram, in at most 16 bands of equal width
+    size_t levels = shape.depthCounts.size();
+    size_t band = (levels + 15) / 16;
+    cout << "Nodes per depth:" << endl;
+    for (size_t lo = 0; lo < levels; lo += band) {
+      size_t hi = (lo + band < levels) ? lo + band : levels;
+      size_t count = 0;
+      for (size_t d = lo; d < hi; d++) {
+        count += shape.depthCounts[d];
+      }
+      string depths = (hi - lo == 1)
+                          ? to_string(lo)
+                          : to_string(lo) + "-" + to_string(hi - 1);
+      cout << "  " << left << setw(14) << depths << count << endl;
+    }
+  }
+  outFile.close();
+}
+
+// --- EXPERIMENT: RANGE SCAN VS FULL TRAVERSAL ---
+// Pulls a slice of about 1% of the Batch IDs once with range() and once by
+// walking every batch and filtering, as a report job would without it
+template <class Engine>
+void MedicineManager<Engine>::runRangeScanExperiment(int n) {
+  resetTree();
+  cout << "\nCreating " << n << " random medicines..." << endl;
+  vector<Medicine> dataset = generateDataset(n);
+  bulkLoad(std::move(dataset));
+
+  // IDs are drawn from B0 ... B(2n - 1), so this slice is about 1%
+  string lo = "B" + to_string(n / 2);
+  string hi = "B" + to_string(n / 2 + n / 50);
+
+  // 1. range(): two O(log n) descents plus the k matches
+  size_t rangeCount = 0;
+  long long rangeUnits = 0;
+  double rangeUs = timePhase<micro>([&] {
+    for (Medicine &med : range(lo, hi)) {
+      rangeCount++;
+      rangeUnits += med.quantity;
+    }
+  });
+
+  // 2. Full traversal with a filter on every batch
+  size_t scanCount = 0;
+  long long scanUnits = 0;
+  uint64_t loKey = keyOf(lo), hiKey = keyOf(hi);
+  double scanUs = timePhase<micro>([&] {
+    for (auto it = begin(); it != end(); ++it) {
+      if (compareKeys(loKey, lo, it.key(), it->batchID) <= 0 &&
+          compareKeys(hiKey, hi, it.key(), it->batchID) >= 0) {
+        scanCount++;
+        scanUnits += it->quantity;
+      }
+    }
+  });
+
+  // 3. Print Analysis Report
+  ofstream outFile(Engine::RESULTS_FILE);
+  outFile << "Range Scan Time (us): " << rangeUs << endl;
+  outFile << "Full Traversal Filter Time (us): " << scanUs << endl;
+  outFile.close();
+
+  cout << "\n--- " << Engine::NAME << " Range Scan " << lo << " to " << hi
+       << " (Size: " << n << ") ---" << endl;
+  cout << "range():        " << rangeUs << " us (" << rangeCount
+       << " batches, " << rangeUnits << " units)" << endl;
+  cout << "Full traversal: " << scanUs << " us (" << scanCount
+       << " batches, " << scanUnits << " units)" << endl;
+}
+
+// --- EXPERIMENT: ORDER STATISTICS VS ITERATOR WALKS ---
+// Answers the same random questions twice: with the subtree counts
+// (rank, select, rangeQuantity) and by walking the ordered iterators,
+// as a tree without the counts has to
+template <class Engine>
+void MedicineManager<Engine>::runOrderStatisticExperiment(int n) {
+  resetTree();
+  cout << "\nCreating " << n << " random medicines..." << endl;
+  vector<Medicine> dataset = generateDataset(n);
+  for (auto &med : dataset) {
+    med.quantity = 1 + rand() % 100;
+  }
+  size_t stored = bulkLoad(std::move(dataset));
+
+  // Each question covers about 10% of the batches
+  const int QUESTIONS = 200;
+  vector<pair<string, string>> slices;
+  vector<size_t> positions;
+  for (int q = 0; q < QUESTIONS; q++) {
+    int lo = rand() % (n * 2);
+    slices.push_back({"B" + to_string(lo), "B" + to_string(lo + n / 5)});
+    positions.push_back(rand() % (stored / 10 + 1));
+  }
+
+  // 1. Subtree counts: two descents per sum, one per select
+  long long fastUnits = 0;
+  size_t fastChecksum = 0;
+  double fastUs = timePhase<micro>([&] {
+    for (int q = 0; q < QUESTIONS; q++) {
+      fastUnits += rangeQuantity(slices[q].first, slices[q].second);
+      fastChecksum += rank(slices[q].first);
+      Medicine *med = select(positions[q]);
+      if (med != nullptr)
+        fastChecksum += med->quantity;
+    }
+  });
+
+  // 2. Iterator walks: visit every batch in the slice / before position
+  long long walkUnits = 0;
+  size_t walkChecksum = 0;
+  double walkUs = timePhase<micro>([&] {
+    for (int q = 0; q < QUESTIONS; q++) {
+      for (Medicine &med : range(slices[q].first, slices[q].second)) {
+        walkUnits += med.quantity;
+      }
+      auto it = begin();
+      for (auto stop = lowerBound(slices[q].first); it != stop; ++it) {
+        walkChecksum++; // Counting up to the slice start gives its rank
+      }
+      it = begin();
+      for (size_t k = 0; k < positions[q] && it != end(); k++) {
+        ++it;
+      }
+      if (it != end())
+        walkChecksum += it->quantity;
+    }
+  });
+  fastUs /= QUESTIONS;
+  walkUs /= QUESTIONS;
+
+  // 3. Print Analysis Report
+  ofstream outFile(Engine::RESULTS_FILE);
+  outFile << "Order Statistics Time (us/question): " << fastUs << endl;
+  outFile << "Iterator Walk Time (us/question): " << walkUs << endl;
+  outFile.close();
+
+  cout << "\n--- " << Engine::NAME
+       << " Rank / Select / Range Sum (Size: " << stored << ") ---" << endl;
+  cout << "Subtree counts: " << fastUs << " us per question (" << fastUnits
+       << " units, checksum " << fastChecksum << ")" << endl;
+  cout << "Iterator walks: " << walkUs << " us per question (" << walkUnits
+       << " units, checksum " << walkChecksum << ")" << endl;
+  resetTree();
+}
+
+// --- EXPERIMENT: FROZEN SNAPSHOT VS POINTER TREE ---
+// Runs the same N random lookups (hits and misses) through the tree and
+// then through the frozen snapshot, and reports lookups per second
+template <class Engine>
+void MedicineManager<Engine>::runFrozenSearchExperiment(int n) {
+  resetTree();
+  cout << "\nCreating " << n << " random medicines..." << endl;
+  vector<Medicine> dataset = generateDataset(n);
+  for (auto &med : dataset) {
+    addMedicine(med, false); // Nodes end up scattered, as in daily use
+  }
+  vector<string> queries;
+  for (int i = 0; i < n; i++) {
+    queries.push_back("B" + to_string(rand() % (n * 2)));
+  }
+
+  // Every query once, counting the hits (so none can be optimised out)
+  auto timeLookups = [&](size_t &hits) {
+    return timePhase<ratio<1>>([&] {
+      for (auto &id : queries) {
+        if (findMedicine(id) != nullptr)
+          hits++;
+      }
+    });
+  };
+
+  // 1. Pointer tree
+  size_t treeHits = 0;
+  double treeSec = timeLookups(treeHits);
+
+  // 2. Freeze, then the same lookups through the snapshot
+  double freezeMs = timePhase<milli>([this] { freeze(); });
+  size_t frozenHits = 0;
+  double frozenSec = timeLookups(frozenHits);
+
+  // 3. Print Analysis Report
+  ofstream outFile(Engine::RESULTS_FILE);
+  outFile << "Pointer Tree Lookups/s: " << n / treeSec << endl;
+  outFile << "Frozen Snapshot Lookups/s: " << n / frozenSec << endl;
+  outFile << "Freeze Time (ms): " << freezeMs << endl;
+  outFile.close();
+
+  cout << "\n--- " << Engine::NAME
+       << " Frozen Snapshot vs Pointer Tree (Size: " << n << ") ---" << endl;
+  cout << "Pointer tree:    " << n / treeSec / 1e6 << " M lookups/s ("
+       << treeHits << " found)" << endl;
+  cout << "Frozen snapshot: " << n / frozenSec / 1e6 << " M lookups/s ("
+       << frozenHits << " found)" << endl;
+  cout << "Freeze time:     " << freezeMs << " ms" << endl;
+}
+
+// --- EXPERIMENT: HASH INDEX VS TREE LOOKUPS ---
+// Runs the same inserts (each with its duplicate check) and N random
+// exact lookups (hits and misses) without and with the hash index; the
+// range query shows the ordered side still answers from the tree
+template <class Engine>
+void MedicineManager<Engine>::runHashIndexExperiment(int n) {
+  cout << "\nCreating " << n << " random medicines..." << endl;
+  vector<Medicine> dataset = generateDataset(n);
+  vector<string> queries;
+  for (int i = 0; i < n; i++) {
+    queries.push_back("B" + to_string(rand() % (n * 2)));
+  }
+  string lo = "B" + to_string(n / 2);
+  string hi = "B" + to_string(n / 2 + n / 50);
+
+  ofstream outFile(Engine::RESULTS_FILE);
+  cout << "\n--- " << Engine::NAME << " Hash Index vs Tree Lookups (Size: "
+       << n << ") ---" << endl;
+  ExperimentTable table(outFile,
+                        {{"Lookup Path", 14, nullptr},
+                         {"Avg Insert (ns)", 22, "Avg Insert Time (ns)"},
+                         {"Avg Search (ns)", 22, "Avg Search Time (ns)"},
+                         {"Hits", 10, nullptr},
+                         {"Units in " + lo + "-" + hi, 0, nullptr}});
+
+  bool modes[2] = {false, true}; // Tree only first, then the hash index
+  for (bool indexed : modes) {
+    setHashIndexEnabled(indexed);
+    resetTree();
+
+    // 1. Insertion, including the duplicate check of every batch
+    double insNs = timePhase<nano>([&] {
+      for (auto &med : dataset) {
+        addMedicine(med, false);
+      }
+    });
+
+    // 2. Exact lookups (hits are counted so they cannot be optimised out)
+    size_t hits = 0;
+    double searchNs = timePhase<nano>([&] {
+      for (auto &id : queries) {
+        hits += findMedicine(id) != nullptr;
+      }
+    });
+
+    // 3. Ordered query (always served by the tree)
+    long long rangeUnits = 0;
+    for (Medicine &med : range(lo, hi)) {
+      rangeUnits += med.quantity;
+    }
+
+    table.row(indexed ? "Hash Index" : "Tree", insNs / n, searchNs / n, hits,
+              rangeUnits);
+  }
+  setHashIndexEnabled(false); // Back to the default lookup path
+  outFile.close();
+}
+
+// --- EXPERIMENT: SIMD NODE SEARCH VS SCALAR LOOP VS STRING TREE ---
+// Times the same N random lookups (hits and misses) with each kernel;
+// per lookup that is one kernel call per level, ~log16(n) in total
+// The baseline is the path the wide nodes replace: a binary tree
+// (TreeEngine, e.g. AVLEngine) with string keys, i.e. searchInternal
+// doing one std::string comparison per node visited
+template <class Engine>
+template <class TreeEngine>
+void MedicineManager<Engine>::runSimdSearchExperiment(int n) {
+  resetTree();
+  cout << "\nCreating " << n << " random medicines..." << endl;
+  vector<Medicine> dataset = generateDataset(n);
+  for (auto &med : dataset) {
+    addMedicine(med, false);
+  }
+  MedicineManager<TreeEngine> tree; // Scratch system for the baseline
+  tree.setKeyEncoding(false);
+  for (auto &med : dataset) {
+    tree.addMedicine(med, false);
+  }
+  vector<string> queries;
+  for (int i = 0; i < n; i++) {
+    queries.push_back("B" + to_string(rand() % (n * 2)));
+  }
+
+  // One untimed pass first (warms the caches), then the timed pass
+  auto timeLookups = [&queries, n](auto find, size_t &found) {
+    for (auto &id : queries) {
+      find(id);
+    }
+    found = 0;
+    double ns = timePhase<nano>([&] {
+      for (auto &id : queries) {
+        if (find(id) != nullptr)
+          found++;
+      }
+    });
+    return ns / n;
+  };
+
+  // 1. The wide nodes with each kernel (SIMD first, then scalar)
+  string kernels[2];
+  double nsPerLookup[3];
+  size_t hits[3];
+  bool modes[2] = {true, false};
+  for (int m = 0; m < 2; m++) {
+    engine.setSimdEnabled(modes[m]);
+    kernels[m] = engine.simdKernel();
+    nsPerLookup[m] = timeLookups(
+        [this](const string &id) { return findMedicine(id); }, hits[m]);
+  }
+  engine.setSimdEnabled(true);
+
+  // 2. The string-keyed binary tree
+  nsPerLookup[2] = timeLookups(
+      [&tree](const string &id) { return tree.findMedicine(id); }, hits[2]);
+
+  // 3. Print Analysis Report
+  string names[3] = {kernels[0] + " wide nodes", kernels[1] + " wide nodes",
+                     string(TreeEngine::NAME) + " string keys"};
+  ofstream outFile(Engine::RESULTS_FILE);
+  cout << "\n--- " << Engine::NAME
+       << " SIMD vs Scalar vs String Tree Search (Size: " << n << ") ---"
+       << endl;
+  ExperimentTable table(outFile, {{"Search", 26, nullptr},
+                                  {"ns/lookup", 14, "Search (ns/lookup)"},
+                                  {"Speedup", 12, nullptr},
+                                  {"Found", 0, nullptr}});
+  for (int m = 0; m < 3; m++) {
+    table.row(names[m], nsPerLookup[m], nsPerLookup[2] / nsPerLookup[m],
+              hits[m]);
+  }
+  outFile.close();
+  cout << "(Speedup: against the " << TreeEngine::NAME
+       << " string-key walk)" << endl;
+}
+
+// ==========================================
+// 3. SHARED BENCHMARK WORKLOADS
+// ==========================================
+
+// Inserts the dataset, looks up the queries, traverses everything once
+// and deletes the dataset again, timing each phase (no printing)
+// The same dataset and queries are given to every engine; hotQueries is
+// a second, skewed lookup phase (e.g. generateZipfQueries)
+template <class Engine>
+WorkloadResult MedicineManager<Engine>::runWorkload(
+    const vector<Medicine> &dataset, const vector<string> &queries,
+    const vector<string> &hotQueries) {
+  WorkloadResult result;
+  resetTree();
+
+  // 1. Insertion (copy-in, so the dataset can be reused)
+  double insNs = timePhase<nano>([&] {
+    for (const auto &med : dataset) {
+      addMedicine(med, false);
+    }
+  });
+
+  // 2. Search (hits and misses)
+  result.hits = 0;
+  double searchNs = timePhase<nano>([&] {
+    for (const auto &id : queries) {
+      if (findMedicine(id) != nullptr)
+        result.hits++;
+    }
+  });
+
+  // 3. Skewed search (hot batches asked for again and again)
+  result.hotHits = 0;
+  double hotNs = timePhase<nano>([&] {
+    for (const auto &id : hotQueries) {
+      if (findMedicine(id) != nullptr)
+        result.hotHits++;
+    }
+  });
+
+  // 4. Full in-order traversal
+  result.stored = 0;
+  result.traverseMs = timePhase<milli>([&] {
+    engine.forEach([&result](const Medicine &) { result.stored++; });
+  });
+
+  // 5. Deletion of every dataset ID (repeated IDs miss the second time)
+  double delNs = timePhase<nano>([&] {
+    for (const auto &med : dataset) {
+      removeMedicine(med.batchID);
+    }
+  });
+
+  size_t n = dataset.empty() ? 1 : dataset.size();
+  size_t q = queries.empty() ? 1 : queries.size();
+  result.insertNs = insNs / n;
+  result.searchNs = searchNs / q;
+  result.hotSearchNs = hotNs / (hotQueries.empty() ? 1 : hotQueries.size());
+  result.deleteNs = delNs / n;
+  return result;
+}
+
+// Stores the workload's preload (untimed), then runs its operation
+// stream in order and times it as a whole
+template <class Engine>
+MixResult
+MedicineManager<Engine>::runMixedWorkload(const MixedWorkload &workload) {
+  MixResult result = {0, 0, 0, 0};
+  resetTree();
+  if constexpr (HasBulkLoad<Engine>::value) {
+    bulkLoad(vector<Medicine>(workload.preload));
+  } else {
+    for (const auto &med : workload.preload) {
+      addMedicine(med, false);
+    }
+  }
+
+  double seconds = timePhase<ratio<1>>([&] {
+    for (const MixStep &step : workload.steps) {
+      bool hit = true;
+      if (step.operation == MIX_INSERT) {
+        addMedicine(workload.inserts[step.index], false);
+        continue;
+      }
+      const string &id = workload.ids[step.index];
+      if (step.operation == MIX_DELETE) {
+        hit = removeMedicine(id);
+      } else if (step.operation == MIX_UPDATE) {
+        hit = updateQuantity(id, step.index % 100); // Stock correction
+      } else {
+        hit = findMedicine(id) != nullptr;
+      }
+      (hit ? result.hits : result.misses)++;
+    }
+  });
+
+  result.opsPerSec = (seconds > 0) ? workload.steps.size() / seconds : 0;
+  engine.forEach([&result](const Medicine &) { result.stored++; });
+  resetTree();
+  return result;
+}
+
+// Inserts, searches and deletes every dataset ID, timing the operations
+// that succeed apart from the rejected ones: a repeated ID is a rejected
+// insert and, the second time, a rejected delete. The first occurrences
+// run in dataset order, then the repeats (all of them rejected, since the
+// ID is stored / already gone by then); the tree is empty again afterwards
+template <class Engine>
+BenchmarkRun
+MedicineManager<Engine>::runBenchmarkRep(const vector<Medicine> &dataset) {
+  BenchmarkRun run = {0, 0, 0, 0, 0, 0, 0, 0};
+  resetTree();
+
+  // 0. Split the dataset (untimed) into first occurrences and repeats
+  vector<const Medicine *> firsts, repeats;
+  unordered_set<string_view> seen;
+  seen.reserve(dataset.size());
+  for (const auto &med : dataset) {
+    (seen.insert(med.batchID).second ? firsts : repeats).push_back(&med);
+  }
+
+  // 1. Insertion (copy-in, so the dataset can be reused)
+  double insNs = timePhase<nano>([&] {
+    for (const Medicine *med : firsts) {
+      run.added += addMedicine(*med, false);
+    }
+  });
+  double rejectedInsNs = timePhase<nano>([&] {
+    for (const Medicine *med : repeats) {
+      addMedicine(*med, false);
+    }
+  });
+
+  // 2. Search (every ID was inserted, so every search hits)
+  double searchNs = timePhase<nano>([&] {
+    for (const auto &med : dataset) {
+      run.found += findMedicine(med.batchID) != nullptr;
+    }
+  });
+
+  // 3. Deletion
+  double delNs = timePhase<nano>([&] {
+    for (const Medicine *med : firsts) {
+      run.removed += removeMedicine(med->batchID);
+    }
+  });
+  double rejectedDelNs = timePhase<nano>([&] {
+    for (const Medicine *med : repeats) {
+      removeMedicine(med->batchID);
+    }
+  });
+
+  // Averages over the operations of each kind (0 when there are none)
+  auto perOp = [](double ns, size_t ops) { return ops ? ns / ops : 0.0; };
+  run.insertNs = perOp(insNs, run.added);
+  run.rejectedInsertNs = perOp(rejectedInsNs, repeats.size());
+  run.searchNs = perOp(searchNs, dataset.size());
+  run.deleteNs = perOp(delNs, run.removed);
+  run.rejectedDeleteNs = perOp(rejectedDelNs, repeats.size());
+  return run;
+}
+
+#endif
@@ -0,0 +1,903 @@
+/*
+ * Name: Lau Su Hui (Abby)
+ * Matric No.: MEC245045
+ * Semester: 20252026-1
+ * Course: MECS1023 ADSA
+ * Group & Theme: Group 1-Pharmacy Inventory Control System
+ * Assignment Title: Medicine Management System (Manager ADT)
+ */
+
+#ifndef MEDICINE_MANAGER_H
+#define MEDICINE_MANAGER_H
+
+#include <algorithm> // For stable_sort, is_sorted (bulk load)
+#include <charconv>  // For from_chars (CSV quantities, no string copy)
+#include <chrono>    // For measuring execution time (performance analysis)
+#include <iostream>
+#include <map>    // For the stock report tables (sorted by name/shelf)
+#include <memory> // For unique_ptr (optional task pool)
+#include <string>
+#include <string_view>
+#include <type_traits> // For void_t (engines with or without bulkLoad)
+#include <utility>     // For move (zero-copy insertion)
+#include <vector>
+
+#include "csv_import.h"
+#include "hash_index.h"
+#include "latency_histogram.h"
+#include "medicine_common.h"
+#include "snapshot_file.h"
+#include "stock_export.h"
+#include "task_pool.h"
+#include "tree_nodes.h" // For TreeStats, WorkCounts (BST & AVL engines)
+#include "wal_file.h"
+
+using namespace std::chrono; // Namespace for time functions
+
+// ==========================================
+// 2. MEDICINE MANAGER CLASS (ADT)
+// ==========================================
+
+// A [first, last) pair of iterators, usable in range-based for loops
+template <class It> struct IteratorRange {
+  It first;
+  It last;
+  It begin() const { return first; }
+  It end() const { return last; }
+};
+
+// Merge step of the stock reports: adds every count of 'from' into 'into'
+template <class Count>
+void mergeCounts(map<string, Count> &into, map<string, Count> &&from) {
+  if (into.size() < from.size())
+    swap(into, from); // Fold the smaller table into the bigger one
+  for (auto &entry : from) {
+    into[entry.first] += entry.second;
+  }
+}
+
+// True for engines that have a bulkLoad (decided at compile time)
+template <class E, class = void> struct HasBulkLoad : false_type {};
+template <class E>
+struct HasBulkLoad<E, void_t<decltype(&E::bulkLoad)>> : true_type {};
+
+// True for engines with ordered iterators (a listing page can stop early)
+template <class E, class = void> struct HasIterators : false_type {};
+template <class E>
+struct HasIterators<E, void_t<decltype(&E::begin)>> : true_type {};
+
+// True for engines that must see a quantity change (subtree unit sums, or
+// records shared with snapshots); the others are written in place
+template <class E, class = void> struct HasQuantityUpdate : false_type {};
+template <class E>
+struct HasQuantityUpdate<E, void_t<decltype(&E::updateQuantity)>>
+    : true_type {};
+
+// Timings of one identical workload, for comparing engines side by side
+struct WorkloadResult {
+  double insertNs;    // Avg time per addMedicine
+  double searchNs;    // Avg time per findMedicine (hits and misses)
+  double hotSearchNs; // Avg time per findMedicine (Zipf-skewed hot batches)
+  double traverseMs;  // One full in-order pass
+  double deleteNs;    // Avg time per removeMedicine
+  size_t stored;      // Batches in the tree after the inserts
+  size_t hits;        // Queries found
+  size_t hotHits;     // Skewed queries found
+};
+
+struct MixedWorkload; // One generated operation mix (mixed_workload.h)
+
+// Throughput of one operation mix (see mixed_workload.h)
+struct MixResult {
+  double opsPerSec; // Operations of every kind per second
+  size_t hits;      // Reads, updates and deletes that found their batch
+  size_t misses;    // ... and those that did not
+  size_t stored;    // Batches stored at the end of the stream
+};
+
+// One timed repetition of the benchmark CLI (same dataset every time)
+struct BenchmarkRun {
+  double insertNs;         // Avg time per addMedicine that stored a batch
+  double rejectedInsertNs; // Avg time per duplicate addMedicine (0 if none)
+  double searchNs;         // Avg time per findMedicine
+  double deleteNs;         // Avg time per removeMedicine that removed one
+  double rejectedDeleteNs; // Avg time per removeMedicine of a gone ID
+  size_t added;            // Inserts that stored a new batch
+  size_t found;            // Searches that found their batch
+  size_t removed;          // Deletes that removed a batch
+};
+
+// Latency histograms of the public operations (see setLatencyTracking)
+struct OperationLatency {
+  LatencyHistogram add;      // addMedicine / emplaceMedicine
+  LatencyHistogram find;     // findMedicine
+  LatencyHistogram remove;   // removeMedicine
+  LatencyHistogram traverse; // showAllMedicines / forEachMedicine
+};
+
+// Outcome of one importCsv call
+struct ImportReport {
+  bool opened;       // False if the file could not be read
+  size_t rows;       // Data rows read (header not counted)
+  size_t imported;   // Batches added
+  size_t rejected;   // Rows that failed validation (nothing added)
+  size_t duplicates; // Valid rows whose Batch ID was already stored
+  bool logged;       // False if the log could not be synced afterwards
+  double seconds;    // Reading, checking and inserting, end to end
+};
+
+// The Medicine Management System on top of a storage engine
+// Every engine provides the same core interface:
+//   NAME, RESULTS_FILE                   label and experiment output file
+//   Medicine *insert(key, Medicine &)    moves the record in if the ID is new
+//                                        (nullptr if it already exists)
+//   Medicine *find(key, batchID)         nullptr if not stored
+//   bool remove(key, batchID)            false if not stored
+//   forEach(visit), clear(), empty()     in Batch ID order
+// Extras (ordered iterators, bulkLoad, updateQuantity, parallel reduce,
+// freeze, node pool, SIMD search) are optional: the members that use them
+// are only compiled for the engines that have them
+template <class Engine> class MedicineManager {
+private:
+  Engine engine;            // The data structure that stores the batches
+  bool useEncodedKeys;      // Switch: true = packed integer keys
+  BatchHashIndex index;     // Exact-match index over the engine's records
+  bool useHashIndex;        // Switch: true = exact lookups go via 'index'
+  WriteAheadLog log;        // Durable record of every change (once opened)
+  OperationLatency latency; // Time histograms of the public operations
+  bool trackLatency;        // Switch: true = time every public operation
+
+  // --- KEY HANDLING ---
+  // Key of a Batch ID under the current mode (STRING_KEY = compare strings)
+  uint64_t keyOf(string_view batchID) {
+    return useEncodedKeys ? encodeBatchID(batchID) : STRING_KEY;
+  }
+
+  // Exact lookup without timing it (for the manager's own checks)
+  Medicine *lookup(string_view batchID) {
+    if (useHashIndex)
+      return index.find(batchID);
+    return engine.find(keyOf(batchID), batchID);
+  }
+
+  // Empties the engine and the hash index together
+  void resetTree() {
+    engine.clear();
+    index.clear();
+  }
+
+  // Helper: Moves a new record into the engine and indexes it (the caller
+  // logs it, if at all)
+  // Returns the stored record, or nullptr (record untouched) if the Batch
+  // ID already exists
+  Medicine *insertRecord(Medicine &med) {
+    Medicine *stored = engine.insert(keyOf(med.batchID), med);
+    if (stored != nullptr && useHashIndex)
+      index.insert(stored);
+    return stored;
+  }
+
+  // Helper: insertRecord and logAdd for the public add calls, with their
+  // error messages. Only the hash index is asked first (O(1)); otherwise
+  // the engine's own insert descent finds a duplicate, so an add costs one
+  // descent instead of a lookup followed by the insert
+  bool addRecord(Medicine &med, bool showErrors) {
+    bool taken = useHashIndex && index.find(med.batchID) != nullptr;
+    Medicine *stored = taken ? nullptr : insertRecord(med);
+    if (stored == nullptr) {
+      if (showErrors) {
+        cout << "Error: Batch ID " << med.batchID << " already exists.🚫"
+             << endl;
+      }
+      return false;
+    }
+    if (!log.isOpen() || log.logAdd(*stored))
+      return true;
+    if (showErrors) {
+      cout << "Error: Batch " << stored->batchID
+           << " was added, but the log could not be saved (it is retried "
+              "on the next change).⚠️"
+           << endl;
+    }
+    return false;
+  }
+
+  // Helper: Re-indexes every stored record (after a bulk change)
+  void rebuildIndex() {
+    index.clear();
+    if (useHashIndex) {
+      engine.forEach([this](Medicine &med) { index.insert(&med); });
+    }
+  }
+
+  // Helper: Appends every batch with a packed key in [loKey, hiKey]
+  void collectKeyRange(uint64_t loKey, uint64_t hiKey,
+                       vector<Medicine *> &out) {
+    for (auto it = engine.bound(loKey, "", false); it != engine.end(); ++it) {
+      if (it.key() > hiKey)
+        break;
+      out.push_back(&*it);
+    }
+  }
+
+  // Helper: Formats the batches at positions [offset, offset + limit)
+  // Engines with iterators stop after the page; the rest walk every batch
+  void writePage(ExportWriter &out, size_t offset, size_t limit) {
+    if constexpr (HasIterators<Engine>::value) {
+      auto it = engine.begin();
+      for (size_t i = 0; i < offset && it != engine.end(); i++) {
+        ++it;
+      }
+      for (size_t i = 0; i < limit && it != engine.end(); i++, ++it) {
+        out.row(*it);
+      }
+    } else {
+      size_t position = 0;
+      engine.forEach([&](const Medicine &med) {
+        if (position >= offset && position - offset < limit)
+          out.row(med);
+        position++;
+      });
+    }
+  }
+
+  // Helper: bulkLoad on an existing pool (nullptr = this thread only),
+  // without logging
+  size_t loadBatches(vector<Medicine> &&batches, TaskPool *pool) {
+    // Sort the incoming batches (pointers only, records stay in place)
+    vector<pair<uint64_t, Medicine *>> incoming(batches.size());
+    auto encode = [&](size_t i) {
+      incoming[i] = {keyOf(batches[i].batchID), &batches[i]};
+    };
+    auto byBatchID = [](const pair<uint64_t, Medicine *> &a,
+                        const pair<uint64_t, Medicine *> &b) {
+      return compareKeys(a.first, a.second->batchID, b.first,
+                         b.second->batchID) < 0;
+    };
+    if (pool) {
+      parallelFor(batches.size(), encode, *pool);
+    } else {
+      for (size_t i = 0; i < batches.size(); i++) {
+        encode(i);
+      }
+    }
+    // Input that is already in order (e.g., a snapshot file) skips the sort
+    if (!is_sorted(incoming.begin(), incoming.end(), byBatchID)) {
+      if (pool) {
+        vector<pair<uint64_t, Medicine *>> buffer(incoming.size());
+        parallelStableSort(incoming.data(),
+                           incoming.data() + incoming.size(), buffer.data(),
+                           byBatchID, *pool);
+      } else {
+        stable_sort(incoming.begin(), incoming.end(), byBatchID);
+      }
+    }
+    size_t added = engine.bulkLoad(incoming, pool);
+    batches.clear();
+    rebuildIndex();
+    return added;
+  }
+
+public:
+  // Constructor: Empty engine, packed keys enabled, no hash index
+  MedicineManager() {
+    useEncodedKeys = true;
+    useHashIndex = false;
+    trackLatency = false;
+  }
+
+  // Name of the storage engine (e.g., "AVL"), used in every report
+  const char *engineName() const { return Engine::NAME; }
+
+  // Switches between the node pool and plain new/delete
+  // Note: The tree is emptied first, since nodes cannot change owner
+  void setPoolEnabled(bool enabled) {
+    engine.setPoolEnabled(enabled);
+    index.clear();
+  }
+
+  // Switches between packed integer keys and plain string keys
+  // Note: The tree is emptied first, since the two modes order IDs
+  // differently (numeric "B9" < "B10" vs. lexicographic "B10" < "B9")
+  void setKeyEncoding(bool enabled) {
+    resetTree();
+    useEncodedKeys = enabled;
+  }
+
+  // Switches the hash index for exact lookups on or off
+  // With it, findMedicine and the duplicate check in addMedicine are O(1)
+  // on average; display, iterators and range queries still use the engine
+  // Note: The index points at records inside the engine, so only engines
+  // whose records never move can have one
+  void setHashIndexEnabled(bool enabled) {
+    static_assert(Engine::STABLE_RECORDS,
+                  "The hash index needs records that never move");
+    useHashIndex = enabled;
+    rebuildIndex();
+  }
+
+  // Public Interface for Insertion
+  // Move-in overload: the record's strings are moved into the engine
+  bool addMedicine(Medicine &&med, bool showErrors = true) {
+    LatencyTimer timer(latency.add, trackLatency);
+    return addRecord(med, showErrors);
+  }
+
+  // Copy-in overload: the caller keeps its record, the engine gets one copy
+  bool addMedicine(const Medicine &med, bool showErrors = true) {
+    LatencyTimer timer(latency.add, trackLatency);
+    Medicine copy = med;
+    return addRecord(copy, showErrors);
+  }
+
+  // Emplace-style insertion: builds the record straight from its fields
+  bool emplaceMedicine(string batchID, string medicineName, int quantity,
+                       string expiryDate, string location,
+                       bool showErrors = true) {
+    return addMedicine(Medicine{std::move(batchID), std::move(medicineName),
+                                quantity, std::move(expiryDate),
+                                std::move(location)},
+                       showErrors);
+  }
+
+  // Public Interface for Bulk Loading (e.g., the nightly stock file)
+  // Sorts the batches, then lets the engine merge them with the batches
+  // already stored and rebuild a perfectly balanced tree in one O(n) pass,
+  // instead of n separate search + insert descents
+  // With threads > 1, key encoding, sorting and linking up the tree are
+  // shared by that many threads (a work-stealing pool); the result is the
+  // same tree as with one thread
+  // Duplicate Batch IDs are skipped like in addMedicine (first one wins)
+  // Returns the number of batches added; the input records are moved from
+  size_t bulkLoad(vector<Medicine> &&batches, int threads = 1) {
+    unique_ptr<TaskPool> pool;
+    if (threads > 1)
+      pool = make_unique<TaskPool>(threads);
+    if (log.isOpen()) {
+      // Replaying these adds one by one skips the same duplicates
+      for (const auto &med : batches) {
+        log.logAdd(med, false);
+      }
+      log.sync(); // One sync for the whole load
+    }
+    return loadBatches(std::move(batches), pool.get());
+  }
+
+  // Public Interface for Search
+  // Returns a pointer to Medicine data if found, otherwise nullptr
+  // Note: Some engines (B+ tree) move records when batches are added or
+  // deleted, so the pointer is only valid until the next add/delete
+  Medicine *findMedicine(string_view batchID) {
+    LatencyTimer timer(latency.find, trackLatency);
+    return lookup(batchID);
+  }
+
+  // Public Interface for Read-Heavy Periods (e.g., between deliveries)
+  // Exports the tree into the frozen snapshot; findMedicine then serves
+  // packed Batch IDs from it until the next insert or delete thaws it
+  // (IDs without a packed key, and string key mode, still use the tree)
+  void freeze() { engine.freeze(); }
+
+  // True while lookups are served by the frozen snapshot
+  bool isFrozen() { return engine.isFrozen(); }
+
+  // Public Interface for Lock-Free Readers (persistent engines)
+  // Opens a consistent, read-only view that other threads can search and
+  // list without locking while this thread keeps adding and deleting
+  auto snapshot() { return engine.snapshot(useEncodedKeys); }
+
+  // Public Interface for Deletion
+  // Returns false if the batch did not exist, or if the log could not be
+  // synced (the batch is gone all the same; its log record stays queued)
+  // (the index entry goes first: it still reads the record's Batch ID)
+  bool removeMedicine(string_view batchID) {
+    LatencyTimer timer(latency.remove, trackLatency);
+    if (useHashIndex && !index.erase(batchID))
+      return false; // Not stored, known without a tree descent
+    // 'batchID' may view the stored record itself, which the remove frees
+    string id(batchID);
+    if (!engine.remove(keyOf(id), id))
+      return false;
+    return !log.isOpen() || log.logRemove(id);
+  }
+
+  // Public Interface for Stock Corrections
+  // Sets the quantity of a stored batch; returns false if it is not stored,
+  // or if the log could not be synced (the new quantity is kept)
+  // Logic: One descent, no restructuring. The record is written in place,
+  // unless the engine has its own updateQuantity (the AVL engine refreshes
+  // the unit sums on the search path; the persistent engine stores a new
+  // record, which the hash index is then pointed at)
+  bool updateQuantity(string_view batchID, int quantity) {
+    Medicine *stored;
+    if constexpr (HasQuantityUpdate<Engine>::value) {
+      Medicine *old = useHashIndex ? index.find(batchID) : nullptr;
+      stored = engine.updateQuantity(keyOf(batchID), batchID, quantity);
+      if (useHashIndex && stored != old)
+        index.replace(old, stored); // 'batchID' may be gone with 'old'
+    } else {
+      stored = lookup(batchID);
+      if (stored != nullptr)
+        stored->quantity = quantity;
+    }
+    if (stored == nullptr)
+      return false;
+    return !log.isOpen() || log.logUpdate(stored->batchID, quantity);
+  }
+
+  // Public Interface for Display (Batch ID order)
+  // Shows the batches at positions offset ... offset + limit - 1 (one
+  // console page; all of them by default), formatted into one buffer and
+  // written in large chunks rather than one flushed line per batch
+  // Returns the number of batches shown
+  size_t showAllMedicines(size_t offset = 0, size_t limit = SIZE_MAX) {
+    if (engine.empty()) {
+      cout << "No medicines in the system.⚠️" << endl;
+      return 0;
+    }
+    LatencyTimer timer(latency.traverse, trackLatency);
+    ExportWriter out(EXPORT_TABLE);
+    out.header();
+    writePage(out, offset, limit);
+    out.flush();
+    return out.rows();
+  }
+
+  // Calls visit(Medicine &) for every batch in Batch ID order (no printing)
+  template <class Visit> void forEachMedicine(Visit visit) {
+    LatencyTimer timer(latency.traverse, trackLatency);
+    engine.forEach(visit);
+  }
+
+  // --- LATENCY HISTOGRAMS (TAIL LATENCY) ---
+  // Times every add, find, remove and traversal into its own histogram
+  // (see latency_histogram.h): two clock readings and a counter increment
+  // per operation, so it can stay on in the menu; the experiments turn it
+  // on only for their latency passes
+  void setLatencyTracking(bool enabled) { trackLatency = enabled; }
+
+  OperationLatency &latencies() { return latency; }
+
+  // Writes p50 / p90 / p99 / p99.9 / max of every operation recorded so far
+  void writeLatencyReport(ostream &out) const {
+    const pair<const char *, const LatencyHistogram *> rows[] = {
+        {"Add", &latency.add},
+        {"Find", &latency.find},
+        {"Remove", &latency.remove},
+        {"Traverse", &latency.traverse}};
+    for (const auto &row : rows) {
+      if (row.second->count() > 0)
+        row.second->writeSummary(out, row.first);
+    }
+  }
+
+  // Deletes every batch (engine and hash index)
+  // Not logged: run compact() afterwards to make an empty inventory stick
+  void clear() { resetTree(); }
+
+  // --- SNAPSHOT FILE (FAST STARTUP) ---
+  // Saves every batch to a binary snapshot (see snapshot_file.h)
+  // Returns the number of batches saved, or -1 if the file was not written
+  long long saveSnapshot(const string &path) {
+    SnapshotWriter writer;
+    engine.forEach([&writer](const Medicine &med) { writer.add(med); });
+    if (!writer.write(path))
+      return -1;
+    return (long long)writer.size();
+  }
+
+  // Replaces the whole inventory with the batches of a snapshot file
+  // (not logged: restore the snapshot first, then openLog)
+  // Logic: The file is mapped into memory and checked (version, size,
+  // checksum) before anything is touched, its records are decoded straight
+  // out of the mapping, and the tree is rebuilt in one bulk load
+  // With threads > 1, decoding and the bulk load share a task pool
+  // Returns the number of batches loaded, or -1 (inventory untouched) if
+  // the file is missing or invalid; only an invalid file is reported
+  long long loadSnapshot(const string &path, int threads = 1,
+                         bool showErrors = true) {
+    MappedFile file;
+    if (!file.open(path))
+      return -1; // No snapshot yet (e.g., the very first start)
+    SnapshotReader reader;
+    string error;
+    if (!reader.open(file, error)) {
+      if (showErrors)
+        cout << "Snapshot " << path << " rejected: " << error << ".❌"
+             << endl;
+      return -1;
+    }
+
+    unique_ptr<TaskPool> pool;
+    if (threads > 1)
+      pool = make_unique<TaskPool>(threads);
+    vector<Medicine> batches(reader.size());
+    auto decode = [&](size_t i) { reader.decode(i, batches[i]); };
+    if (pool) {
+      parallelFor(batches.size(), decode, *pool);
+    } else {
+      for (size_t i = 0; i < batches.size(); i++) {
+        decode(i);
+      }
+    }
+
+    resetTree();
+    if constexpr (HasBulkLoad<Engine>::value) {
+      loadBatches(std::move(batches), pool.get());
+    } else {
+      for (auto &med : batches) {
+        insertRecord(med); // Engines without bulkLoad (e.g., B+ tree)
+      }
+    }
+    return (long long)reader.size();
+  }
+  // --- WRITE-AHEAD LOG (DURABLE CHANGES) ---
+  // Replays the log at 'path' on top of the current inventory (normally
+  // the latest snapshot), then logs every later change to it
+  // Group commit: the log is synced once 'groupSize' changes are waiting
+  // or 'groupMs' ms have passed (see wal_file.h); 1 = sync every change
+  // Returns the number of changes replayed, or -1 if the log is unusable
+  long long openLog(const string &path, size_t groupSize = 1,
+                    int groupMs = 0) {
+    log.close();
+    long long replayed = WriteAheadLog::replay(
+        path,
+        [this](Medicine &&med) { insertRecord(med); },
+        [this](const string &batchID) { removeMedicine(batchID); },
+        [this](const string &batchID, int quantity) {
+          updateQuantity(batchID, quantity);
+        });
+    if (replayed < 0 || !log.open(path, groupSize, groupMs))
+      return -1;
+    return replayed;
+  }
+
+  // Forces the waiting group of changes onto the disk now
+  bool syncLog() { return log.sync(); }
+
+  // Syncs and closes the log (later changes are no longer logged)
+  // Returns false if the last changes could not be synced
+  bool closeLog() { return log.close(); }
+
+  // Number of fsyncs the log has done (for the experiment)
+  size_t logSyncCount() const { return log.syncCount(); }
+
+  // Compaction: saves the inventory to a snapshot, then empties the log,
+  // whose changes the snapshot now holds
+  // A crash between the two steps only replays changes the snapshot
+  // already has, which ends in the same inventory (adds of stored IDs are
+  // skipped, and the last change of each ID decides its state)
+  // Returns the number of batches saved, or -1 on an I/O error
+  long long compact(const string &snapshotPath) {
+    long long saved = saveSnapshot(snapshotPath);
+    if (saved < 0 || (log.isOpen() && !log.reset()))
+      return -1;
+    return saved;
+  }
+
+  // --- STOCK EXPORT (CSV / JSON LINES / TABLE) ---
+  // Writes the batches at positions [offset, offset + limit) in Batch ID
+  // order to a file (see stock_export.h); a CSV export can be imported
+  // again with importCsv
+  // Returns the number of batches written, or -1 if the file could not be
+  // written
+  long long exportMedicines(const string &path, ExportFormat format,
+                            size_t offset = 0, size_t limit = SIZE_MAX) {
+    ExportWriter out(format);
+    if (!out.open(path))
+      return -1;
+    out.header();
+    writePage(out, offset, limit);
+    if (!out.close())
+      return -1;
+    return (long long)out.rows();
+  }
+
+  // --- CSV IMPORT (SUPPLIER STOCK FILES) ---
+  // Adds every valid row of a CSV stock file:
+  //   Batch ID,Medicine Name,Quantity,Expiry Date,Location
+  // (quotes allowed, e.g. "Ascorbic Acid, 1000mg"; the first row is
+  // skipped as the header only if its first field is "Batch ID", in any
+  // case, and is checked like any other row otherwise)
+  // Logic: The file streams through CsvReader in 1 MB chunks and every row
+  // is checked in place (field count, non-empty text, whole-number
+  // quantity >= 0, isValidDate) before a single string is built. Into an
+  // empty system the rows are collected and built into the tree with one
+  // bulk load; otherwise they go in one by one (duplicates skipped) and
+  // the log syncs once at the end instead of once per row
+  // With showErrors, the first few rejected rows are printed with a reason
+  ImportReport importCsv(const string &path, bool showErrors = true) {
+    const size_t MAX_SHOWN = 5; // Rejected rows printed at most
+    ImportReport report = {false, 0, 0, 0, 0, true, 0.0};
+    bool bulk = false;
+    if constexpr (HasBulkLoad<Engine>::value)
+      bulk = engine.empty();
+    vector<Medicine> batches; // Rows for the bulk load
+    bool firstRow = true;
+
+    auto reject = [&](size_t line, const char *reason) {
+      if (showErrors && report.rejected < MAX_SHOWN)
+        cout << "Line " << line << " rejected: " << reason << ".❌" << endl;
+      report.rejected++;
+    };
+
+    auto start = high_resolution_clock::now();
+    CsvReader reader;
+    report.opened = reader.read(
+        path, [&](const vector<string_view> &fields, size_t line) {
+          // 1. Header row: only the first row, and only if it starts with
+          // the "Batch ID" title (a typo in row 1 is rejected, not skipped)
+          if (firstRow) {
+            firstRow = false;
+            if (isBatchIdHeader(fields[0]))
+              return;
+          }
+          report.rows++;
+          int quantity = 0;
+          bool numeric = false;
+          if (fields.size() > 2) {
+            string_view q = fields[2];
+            auto parsed = from_chars(q.data(), q.data() + q.size(), quantity);
+            numeric = parsed.ec == errc() && parsed.ptr == q.data() + q.size();
+          }
+
+          // 2. Validate in place (string_views into the reader's chunk)
+          if (fields.size() != 5) {
+            reject(line, "expected 5 fields");
+            return;
+          }
+          if (fields[0].empty() || fields[1].empty() || fields[4].empty()) {
+            reject(line, "empty Batch ID, name or location");
+            return;
+          }
+          if (!numeric || quantity < 0) {
+            reject(line, "quantity is not a whole number >= 0");
+            return;
+          }
+          if (!isValidDate(fields[3])) {
+            reject(line, "expiry date is not DD-MMM-YYYY");
+            return;
+          }
+
+          // 3. Build the record (the only string copies of the row)
+          Medicine med{string(fields[0]), string(fields[1]), quantity,
+                       string(fields[3]), string(fields[4])};
+          if (bulk) {
+            batches.push_back(std::move(med));
+          } else if (Medicine *stored = insertRecord(med)) {
+            if (log.isOpen())
+              log.logAdd(*stored, false); // Synced below
+            report.imported++;
+          } else {
+            report.duplicates++;
+          }
+        });
+
+    // 4. Bulk path: one sorted build for the whole file
+    if constexpr (HasBulkLoad<Engine>::value) {
+      if (bulk) {
+        size_t valid = batches.size();
+        report.imported = bulkLoad(std::move(batches));
+        report.duplicates = valid - report.imported;
+      }
+    }
+    if (log.isOpen())
+      report.logged = log.sync();
+    auto stop = high_resolution_clock::now();
+    report.seconds =
+        (double)duration_cast<microseconds>(stop - start).count() / 1e6;
+    if (showErrors && report.rejected > MAX_SHOWN)
+      cout << "... and " << report.rejected - MAX_SHOWN
+           << " more rejected rows." << endl;
+    return report;
+  }
+
+
+  // --- STOCK REPORTS (AGGREGATION) ---
+  // Folds every batch into one Partial result (e.g., units per medicine)
+  //   add(Partial &, const Medicine &)     counts one batch in
+  //   merge(Partial &into, Partial &&from) combines two partial results
+  // With threads > 1 the subtrees are split over a task pool, each folded
+  // into its own Partial and merged afterwards, so add and merge must give
+  // the same result in any order (sums, counts, per-key totals)
+  template <class Partial, class Add, class Merge>
+  Partial aggregate(Add add, Merge merge, int threads = 1) {
+    if (threads <= 1)
+      return engine.template reduce<Partial>(add, merge, nullptr, 0);
+    // About 8 subtrees per thread, so a lopsided half is evened out
+    int forkDepth = 3;
+    for (int t = 1; t < threads; t *= 2) {
+      forkDepth++;
+    }
+    TaskPool pool(threads);
+    return engine.template reduce<Partial>(add, merge, &pool, forkDepth);
+  }
+
+  // Total units in stock per medicine name (all batches)
+  map<string, long long> unitsPerMedicine(int threads = 1) {
+    return aggregate<map<string, long long>>(
+        [](map<string, long long> &units, const Medicine &med) {
+          units[med.medicineName] += med.quantity;
+        },
+        mergeCounts<long long>, threads);
+  }
+
+  // Number of batches stored on each shelf
+  map<string, size_t> batchesPerLocation(int threads = 1) {
+    return aggregate<map<string, size_t>>(
+        [](map<string, size_t> &batches, const Medicine &med) {
+          batches[med.location]++;
+        },
+        mergeCounts<size_t>, threads);
+  }
+
+  // Units expiring in each month, keyed by the date's "MMM-YYYY" part
+  // (e.g., "01-JAN-2027" counts towards "JAN-2027")
+  map<string, long long> expiringPerMonth(int threads = 1) {
+    return aggregate<map<string, long long>>(
+        [](map<string, long long> &units, const Medicine &med) {
+          size_t dash = med.expiryDate.find('-');
+          string month = (dash == string::npos)
+                             ? med.expiryDate
+                             : med.expiryDate.substr(dash + 1);
+          units[month] += med.quantity;
+        },
+        mergeCounts<long long>, threads);
+  }
+
+  // --- ORDERED ITERATION & RANGE SCANS ---
+  // Forward iterators over the batches in Batch ID order (no printing)
+  // Note: Any add/remove invalidates existing iterators
+  auto begin() { return engine.begin(); }
+  auto end() { return engine.end(); }
+
+  // First batch with an ID >= batchID, in O(log n)
+  auto lowerBound(string_view batchID) {
+    return engine.bound(keyOf(batchID), batchID, false);
+  }
+
+  // First batch with an ID > batchID, in O(log n)
+  auto upperBound(string_view batchID) {
+    return engine.bound(keyOf(batchID), batchID, true);
+  }
+
+  // All batches with lo <= ID <= hi, in O(log n + k)
+  // e.g. for (Medicine &med : system.range("B1000", "B1999")) { ... }
+  auto range(string_view lo, string_view hi) {
+    IteratorRange<decltype(engine.end())> r{lowerBound(lo), upperBound(hi)};
+    if (compareKeys(keyOf(lo), lo, keyOf(hi), hi) > 0) {
+      r.first = r.last; // Empty range
+    }
+    return r;
+  }
+
+  // Prefix scan: every batch whose ID starts with 'prefix' (e.g., "B30")
+  // Under packed keys the matches are not one contiguous run ("B30" is
+  // followed by "B31", while "B300" comes much later), so they are gathered
+  // from one key range per ID length, plus the string-keyed IDs
+  // Cost: O(log n) per range (at most 15) + O(k) for k matches
+  vector<Medicine *> prefixScan(string_view prefix) {
+    vector<Medicine *> out;
+    if (prefix.empty()) {
+      // Every ID matches an empty prefix
+      for (auto it = begin(); it != end(); ++it) {
+        out.push_back(&*it);
+      }
+      return out;
+    }
+    if (useEncodedKeys) {
+      // 1. Split the prefix into its letters and the digits after them
+      size_t letters = 0;
+      while (letters < prefix.size() && prefix[letters] >= 'A' &&
+             prefix[letters] <= 'Z') {
+        letters++;
+      }
+      string_view digits = prefix.substr(letters);
+      bool packable = letters >= 1 && letters <= 3 && digits.size() <= 14;
+      for (char c : digits) {
+        packable = packable && c >= '0' && c <= '9';
+      }
+
+      if (packable) {
+        uint64_t letterCode = 0;
+        for (size_t i = 0; i < 3; i++) {
+          letterCode = letterCode * 32 +
+                       (i < letters ? (uint64_t)(prefix[i] - 'A' + 1) : 0);
+        }
+        if (digits.empty()) {
+          // 2a. Letters only: every packed ID whose letters extend them
+          uint64_t span = 1;
+          for (size_t i = letters; i < 3; i++) {
+            span *= 32;
+          }
+          collectKeyRange(letterCode << 48,
+                          ((letterCode + span) << 48) - 1, out);
+        } else if (digits[0] == '0') {
+          // 2b. A leading zero only packs as the number 0 itself ("B0")
+          if (digits.size() == 1) {
+            collectKeyRange(letterCode << 48, letterCode << 48, out);
+          }
+        } else {
+          // 2c. Same letters, number = digits followed by 0..k more digits
+          uint64_t number = 0;
+          for (char c : digits) {
+            number = number * 10 + (uint64_t)(c - '0');
+          }
+          uint64_t scale = 1;
+          for (size_t length = digits.size(); length <= 14; length++) {
+            collectKeyRange((letterCode << 48) | (number * scale),
+                            (letterCode << 48) | ((number + 1) * scale - 1),
+                            out);
+            scale *= 10;
+          }
+        }
+      }
+    }
+
+    // 3. String-keyed IDs sort lexicographically, so they form one run
+    for (auto it = engine.bound(STRING_KEY, prefix, false); it != end(); ++it) {
+      if (it->batchID.compare(0, prefix.size(), prefix) != 0)
+        break;
+      out.push_back(&*it);
+    }
+    return out;
+  }
+
+  // --- ORDER STATISTICS (ENGINES WITH SUBTREE COUNTS, e.g. AVL) ---
+  // Number of batches with a smaller Batch ID, i.e. the 0-based position
+  // of the batch in ID order, in O(log n)
+  size_t rank(string_view batchID) {
+    return engine.rank(keyOf(batchID), batchID);
+  }
+
+  // The batch at 0-based position k in ID order, in O(log n)
+  // e.g. select(499) is the 500th batch (nullptr if there are fewer)
+  Medicine *select(size_t k) { return engine.select(k); }
+
+  // Total units held across lo <= Batch ID <= hi, in O(log n)
+  // e.g. rangeQuantity("B1000", "B1999")
+  long long rangeQuantity(string_view lo, string_view hi) {
+    return engine.rangeQuantity(keyOf(lo), lo, keyOf(hi), hi);
+  }
+
+  // --- TREE SHAPE & WORK COUNTERS (BST & AVL ENGINES) ---
+  // Height, average depth and nodes per depth of the stored tree
+  TreeStats treeStats() { return engine.treeStats(); }
+
+  // Key comparisons, nodes visited and rotations by case since the last
+  // reset (all zero unless the engine is a Counting one, e.g.
+  // CountingAVLEngine; the normal engines compile the counting out)
+  WorkCounts workCounts() const { return engine.workCounts(); }
+  void resetWorkCounts() { engine.resetWorkCounts(); }
+
+  // --- EXPERIMENT MODE & SHARED BENCHMARKS ---
+  // Defined in medicine_experiments.h, which every program that runs them
+  // includes instead of this file; each one works on this system, so the
+  // menu hands it a separate, empty one
+  void runExperiment(int n);
+  void runPoolExperiment(int n);
+  void runAllocationExperiment(int n);
+  void runKeyEncodingExperiment(int n);
+  void runBulkLoadExperiment(int maxN);
+  void runParallelBuildExperiment(int n);
+  void runAggregationExperiment(int n);
+  void runSnapshotExperiment(int n);
+  void runLogExperiment(int n);
+  void runCsvImportExperiment(int n);
+  void runExportExperiment(int n);
+  void runSortedInputExperiment(int n);
+  void runTreeShapeExperiment(int n);
+  void runRangeScanExperiment(int n);
+  void runOrderStatisticExperiment(int n);
+  void runFrozenSearchExperiment(int n);
+  void runHashIndexExperiment(int n);
+  template <class TreeEngine> void runSimdSearchExperiment(int n);
+
+  WorkloadResult runWorkload(const vector<Medicine> &dataset,
+                             const vector<string> &queries,
+                             const vector<string> &hotQueries);
+  MixResult runMixedWorkload(const MixedWorkload &workload);
+  BenchmarkRun runBenchmarkRep(const vector<Medicine> &dataset);
+};
+
+#endif
@@ -0,0 +1,309 @@
+/*
+ * Name: Lau Su Hui (Abby)
+ * Matric No.: MEC245045
+ * Semester: 20252026-1
+ * Course: MECS1023 ADSA
+ * Group & Theme: Group 1-Pharmacy Inventory Control System
+ * Assignment Title: Medicine Management System (User Interface)
+ */
+
+#ifndef MEDICINE_MENU_H
+#define MEDICINE_MENU_H
+
+#include <chrono> // For measuring execution time (performance analysis)
+#include <ctime>  // For seeding random generator
+#include <iostream>
+#include <limits> // For clearing input buffer
+#include <string>
+#include <thread> // For hardware_concurrency (snapshot loading)
+
+#include "latency_histogram.h"
+#include "medicine_common.h"
+
+using namespace std::chrono; // Namespace for time functions
+
+// ==========================================
+// 3. UTILITY FUNCTIONS
+// ==========================================
+
+// Clears the input buffer to prevent infinite loops on invalid input
+inline void clearInputBuffer() {
+  cin.clear();
+  cin.ignore(numeric_limits<streamsize>::max(), '\n');
+}
+
+// Ensures the user enters a valid integer (prevents crashing)
+inline int getValidInt() {
+  int value;
+  while (!(cin >> value)) {
+    cout << "Invalid input. Please enter a number: ";
+    cin.clear();                                         // Clear error flag
+    cin.ignore(numeric_limits<streamsize>::max(), '\n'); // Discard bad input
+  }
+  cin.ignore();
+  return value;
+}
+
+// Prints the time of the operation just done, with the running p50 / p99
+// of that operation over this session
+inline void printExecutionTime(const LatencyHistogram &histogram) {
+  cout << "Execution Time: " << histogram.last() << " nanoseconds (p50 "
+       << histogram.percentile(50) << ", p99 " << histogram.percentile(99)
+       << " over " << histogram.count() << " this session)" << endl;
+}
+
+// The inventory is kept here between runs: the snapshot is loaded on start
+// and rewritten on exit, and the log holds every change made in between
+// (synced before the menu continues, so a crash loses nothing)
+const char *const INVENTORY_SNAPSHOT = "inventory.snap";
+const char *const INVENTORY_LOG = "inventory.log";
+
+// One entry of the "Performance Experiment" sub-menu
+template <class Manager> struct ExperimentOption {
+  const char *label;           // e.g. "Standard Report (Insert/Search)"
+  void (Manager::*run)(int n); // The experiment, given the dataset size N
+};
+
+// ==========================================
+// 4. MAIN PROGRAM (USER INTERFACE)
+// ==========================================
+
+// The interactive menu shared by every solution
+// 'experiments' lists the sub-menu of option 5; entry 1 is the default
+template <class Manager, size_t COUNT>
+void runMainMenu(Manager &system, const char *addedMessage,
+                 const ExperimentOption<Manager> (&experiments)[COUNT]) {
+  srand(time(0)); // Seed random generator
+  int choice;
+
+  // Restore the inventory saved by the last run
+  int cores = (int)thread::hardware_concurrency();
+  auto startLoad = high_resolution_clock::now();
+  long long loaded = system.loadSnapshot(INVENTORY_SNAPSHOT, cores);
+  auto stopLoad = high_resolution_clock::now();
+  if (loaded >= 0) {
+    cout << "Loaded " << loaded << " batches from " << INVENTORY_SNAPSHOT
+         << " in " << duration_cast<milliseconds>(stopLoad - startLoad).count()
+         << " ms📂" << endl;
+  }
+  long long replayed = system.openLog(INVENTORY_LOG);
+  if (replayed > 0) {
+    cout << "Replayed " << replayed << " changes from " << INVENTORY_LOG
+         << "📂" << endl;
+  } else if (replayed < 0) {
+    cout << "Could not open " << INVENTORY_LOG
+         << "; changes will not be saved.⚠️" << endl;
+  }
+  if (loaded < 0 && replayed <= 0) {
+    // First start: pre-load some sample data
+    system.addMedicine(
+        {"B303", "Ascorbic Acid 1000mg", 100, "03-MAR-2027", "Shelf A01"});
+    system.addMedicine(
+        {"B101", "Insulin Pen U-100", 20, "01-JAN-2027", "Fridge FR01"});
+    system.addMedicine(
+        {"B505", "Paracetamol 500mg", 500, "05-MAY-2027", "Shelf P02"});
+  }
+  // Every menu action from here on is timed into its latency histogram
+  system.setLatencyTracking(true);
+
+  do {
+    // Main Menu
+    cout << "\nWelcome to the Medicine Management System!💊" << endl;
+    cout << "\n=== Medicine Management System (" << system.engineName()
+         << ") ===" << endl;
+    cout << "1. Add New Medicine Batch➕" << endl;
+    cout << "2. Search by Batch ID🔎" << endl;
+    cout << "3. Display All Batches💻" << endl;
+    cout << "4. Delete Batch➖" << endl;
+    cout << "5. Analysis Report: Run Performance Experiment📊" << endl;
+    cout << "6. Import Stock File (CSV)📥" << endl;
+    cout << "7. Export Stock File (CSV / JSON Lines)📤" << endl;
+    cout << "8. Exit👋" << endl;
+    cout << "Enter your choice: ";
+
+    // Validate Menu Input
+    if (!(cin >> choice)) {
+      cout << "Invalid choice. Please enter a number.⚠️" << endl;
+      clearInputBuffer();
+      continue;
+    }
+    cin.ignore();
+
+    // Handle Menu Choices
+    if (choice == 1) {
+      Medicine med;
+      cout << "\n--- ➕Add Medicine Batch➕ ---" << endl;
+      cout << "Enter Batch ID (e.g., B202): ";
+      getline(cin, med.batchID);
+      cout << "Enter Medicine Name: ";
+      getline(cin, med.medicineName);
+
+      cout << "Enter Quantity: ";
+      med.quantity = getValidInt(); // Use valid int input
+
+      while (true) {
+        cout << "Enter Expiry Date (DD-MMM-YYYY, e.g., 01-JAN-2027): ";
+        getline(cin, med.expiryDate);
+        if (isValidDate(med.expiryDate)) {
+          break;
+        } else {
+          cout
+              << "Invalid format! Please use DD-MMM-YYYY (e.g., 01-JAN-2027).❌"
+              << endl;
+        }
+      }
+
+      cout << "Enter Location (e.g., Shelf A01): ";
+      getline(cin, med.location);
+
+      // Insertion (timed by the manager's latency histogram)
+      bool isAdded = system.addMedicine(med);
+      if (isAdded) {
+        cout << addedMessage << endl;
+        printExecutionTime(system.latencies().add);
+      }
+    } else if (choice == 2) {
+      string id;
+      cout << "\n--- 🔎Search Medicine🔎 ---" << endl;
+      cout << "Enter Batch ID to search: ";
+      getline(cin, id);
+
+      // Search (timed by the manager's latency histogram)
+      Medicine *foundMed = system.findMedicine(id);
+
+      if (foundMed != nullptr) {
+        cout << "\n[FOUND] Batch Details:" << endl;
+        cout << "Batch ID: " << foundMed->batchID << endl;
+        cout << "Name:     " << foundMed->medicineName << endl;
+        cout << "Quantity: " << foundMed->quantity << endl;
+        cout << "Expiry:   " << foundMed->expiryDate << endl;
+        cout << "Location: " << foundMed->location << endl;
+      } else {
+        cout << "\n[NOT FOUND] Batch " << id << " does not exist.❌" << endl;
+      }
+      printExecutionTime(system.latencies().find);
+
+    } else if (choice == 3) {
+      cout << "\n--- 💊All Medicine Batches💊 ---" << endl;
+      cout << "Batches per page (0 = all at once): ";
+      int pageSize = getValidInt();
+
+      // One page at a time (each timed), until a short page or 'q'
+      size_t offset = 0;
+      size_t limit = (pageSize > 0) ? (size_t)pageSize : SIZE_MAX;
+      while (true) {
+        // Traversal (timed by the manager's latency histogram)
+        size_t shown = system.showAllMedicines(offset, limit);
+        if (shown > 0)
+          printExecutionTime(system.latencies().traverse);
+        offset += shown;
+        if (shown < limit)
+          break;
+        cout << "Shown " << offset << " batches. Enter = next page, "
+             << "q = back to menu: ";
+        string answer;
+        if (!getline(cin, answer) || answer == "q")
+          break;
+      }
+
+    } else if (choice == 4) {
+      string id;
+      cout << "\n--- ➖Delete Batch➖ ---" << endl;
+      cout << "Enter Batch ID to delete: ";
+      getline(cin, id);
+
+      // Deletion (timed by the manager's latency histogram)
+      system.removeMedicine(id);
+      cout << "Delete operation completed.✅" << endl;
+      printExecutionTime(system.latencies().remove);
+
+    } else if (choice == 5) { // Experiment Mode
+      int n;
+      cout << "\n--- 📊Performance Experiment📊 ---" << endl;
+      for (size_t i = 0; i < COUNT; i++) {
+        cout << i + 1 << ". " << experiments[i].label << endl;
+      }
+      cout << "Select experiment: ";
+      int experiment = getValidInt();
+      cout << "Enter dataset size N (e.g. 1000, 5000, 10000): ";
+      if (cin >> n) {
+        // Unknown numbers fall back to the standard report
+        size_t index = (experiment >= 1 && (size_t)experiment <= COUNT)
+                           ? (size_t)experiment - 1
+                           : 0;
+        // A separate system, so the experiment never touches the inventory
+        // (or its log)
+        Manager lab;
+        (lab.*experiments[index].run)(n);
+      } else {
+        cout << "Invalid number.❌" << endl;
+        clearInputBuffer();
+      }
+
+    } else if (choice == 6) {
+      string path;
+      cout << "\n--- 📥Import Stock File📥 ---" << endl;
+      cout << "Columns: Batch ID,Medicine Name,Quantity,Expiry Date,Location"
+           << endl;
+      cout << "Enter CSV file path: ";
+      getline(cin, path);
+
+      ImportReport report = system.importCsv(path);
+      if (!report.opened) {
+        cout << "Could not read " << path << ".❌" << endl;
+      } else {
+        double rate = (report.seconds > 0) ? report.rows / report.seconds : 0;
+        cout << "Imported " << report.imported << " of " << report.rows
+             << " rows (" << report.rejected << " rejected, "
+             << report.duplicates << " duplicate Batch IDs).✅" << endl;
+        cout << "Import Time: " << report.seconds * 1000 << " ms ("
+             << (long long)rate << " rows/sec)" << endl;
+        if (!report.logged)
+          cout << "Warning: The log could not be saved (it is retried on the "
+                  "next change).⚠️"
+               << endl;
+      }
+
+    } else if (choice == 7) {
+      string path;
+      cout << "\n--- 📤Export Stock File📤 ---" << endl;
+      cout << "1. CSV (can be imported again)" << endl;
+      cout << "2. JSON Lines" << endl;
+      cout << "Select format: ";
+      int format = getValidInt();
+      cout << "Enter output file path: ";
+      getline(cin, path);
+
+      auto start = high_resolution_clock::now();
+      long long written = system.exportMedicines(
+          path, (format == 2) ? EXPORT_JSON_LINES : EXPORT_CSV);
+      auto stop = high_resolution_clock::now();
+      if (written >= 0) {
+        cout << "Exported " << written << " batches to " << path << ".✅"
+             << endl;
+        cout << "Export Time: "
+             << duration_cast<milliseconds>(stop - start).count() << " ms"
+             << endl;
+      } else {
+        cout << "Could not write " << path << ".❌" << endl;
+      }
+
+    } else if (choice == 8) {
+      long long saved = system.compact(INVENTORY_SNAPSHOT);
+      if (saved >= 0) {
+        cout << "Saved " << saved << " batches to " << INVENTORY_SNAPSHOT
+             << ".💾" << endl;
+      } else {
+        cout << "Could not save " << INVENTORY_SNAPSHOT << ".❌" << endl;
+      }
+      cout << "\n--- Session Latency ---" << endl;
+      system.writeLatencyReport(cout);
+      cout << "Exiting... Goodbye!👋" << endl;
+    } else {
+      cout << "Invalid choice.❌" << endl;
+    }
+
+  } while (choice != 8); // Loop until user chooses to exit
+}
+
+#endif
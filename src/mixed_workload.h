@@ -0,0 +1,143 @@
+/*
+ * Name: Lau Su Hui (Abby)
+ * Matric No.: MEC245045
+ * Semester: 20252026-1
+ * Course: MECS1023 ADSA
+ * Group & Theme: Group 1-Pharmacy Inventory Control System
+ * Assignment Title: Medicine Management System (Mixed Workloads)
+ */
+
+#ifndef MIXED_WORKLOAD_H
+#define MIXED_WORKLOAD_H
+
+#include <cstdint>
+#include <random> // For mt19937_64 (the same operations for every engine)
+#include <string>
+#include <unordered_map> // For the live-batch positions (generation only)
+#include <vector>
+
+#include "medicine_common.h"
+
+// ==========================================
+// MIXED WORKLOADS (YCSB-STYLE OPERATION MIXES)
+// ==========================================
+
+enum MixOperation : uint8_t {
+  MIX_READ,   // findMedicine
+  MIX_UPDATE, // updateQuantity (a stock correction)
+  MIX_INSERT, // addMedicine of a new batch
+  MIX_DELETE, // removeMedicine
+};
+
+// Shares of each operation in percent (adding up to 100)
+// 'missPercent' of the reads and deletes ask for Batch IDs that are not
+// stored (e.g., a mistyped ID at the counter)
+struct OperationMix {
+  const char *label;
+  int readPercent;
+  int updatePercent;
+  int insertPercent;
+  int deletePercent;
+  int missPercent;
+};
+
+// The mixes of the Engine Benchmark (A, B and C follow YCSB)
+//   A  busy counter: half lookups, half stock corrections
+//   B  mostly lookups
+//   C  lookups only, 1 in 5 for a Batch ID that is not stored
+//   Insert-Heavy  deliveries arriving
+//   Delete Churn  batches coming in and going out, with many misses
+const OperationMix STANDARD_MIXES[] = {
+    {"A 50/50 R/U", 50, 50, 0, 0, 0},
+    {"B 95/5 R/U", 95, 5, 0, 0, 0},
+    {"C Read+Miss", 100, 0, 0, 0, 20},
+    {"Insert-Heavy", 20, 0, 80, 0, 5},
+    {"Delete Churn", 30, 0, 35, 35, 25},
+};
+
+// One operation of a stream: what to do, and with which ID
+struct MixStep {
+  MixOperation operation;
+  uint32_t index; // Into 'ids', or into 'inserts' for MIX_INSERT
+};
+
+// A ready-made operation stream (built before any timing starts)
+struct MixedWorkload {
+  vector<Medicine> preload; // Stored before the stream starts
+  vector<string> ids;       // Batch IDs of reads, updates and deletes
+  vector<Medicine> inserts; // New batches, in insert order
+  vector<MixStep> steps;    // The operations, in order
+};
+
+// Generates 'preload' batches plus an 'ops'-long stream in the given mix
+// Logic: Stored Batch IDs are even numbers drawn at random from a space
+// four times the largest possible inventory, so inserts land all over the
+// tree (not only at its right edge); misses use odd numbers, which are
+// never stored. The generator keeps track of which batches are stored, so
+// every hit really targets a stored batch at that point of the stream
+inline MixedWorkload generateMixedWorkload(size_t preload, size_t ops,
+                                           const OperationMix &mix,
+                                           mt19937_64 &rng) {
+  MixedWorkload w;
+  uint64_t space = 4 * (uint64_t)(preload + ops + 1); // Even IDs < space
+  uniform_int_distribution<uint64_t> pickHalf(0, space / 2 - 1);
+  uniform_int_distribution<int> percent(0, 99);
+  vector<uint64_t> live;                // Stored IDs
+  unordered_map<uint64_t, size_t> slot; // ID -> position in 'live'
+
+  auto makeMedicine = [](uint64_t id, size_t i) {
+    return Medicine{"B" + to_string(id), "Med " + to_string(i), 10,
+                    "01-JAN-2027", "Shelf"};
+  };
+  auto freshId = [&]() {
+    uint64_t id;
+    do {
+      id = 2 * pickHalf(rng);
+    } while (slot.count(id) != 0);
+    slot[id] = live.size();
+    live.push_back(id);
+    return id;
+  };
+  auto liveId = [&]() {
+    return live[uniform_int_distribution<size_t>(0, live.size() - 1)(rng)];
+  };
+  auto addStep = [&w](MixOperation operation, uint64_t id) {
+    w.steps.push_back({operation, (uint32_t)w.ids.size()});
+    w.ids.push_back("B" + to_string(id));
+  };
+
+  for (size_t i = 0; i < preload; i++) {
+    w.preload.push_back(makeMedicine(freshId(), i));
+  }
+
+  for (size_t i = 0; i < ops; i++) {
+    int roll = percent(rng);
+    bool miss = percent(rng) < mix.missPercent || live.empty();
+    uint64_t missId = 2 * pickHalf(rng) + 1;
+    if (roll < mix.readPercent) {
+      addStep(MIX_READ, miss ? missId : liveId());
+    } else if (roll < mix.readPercent + mix.updatePercent) {
+      addStep(live.empty() ? MIX_READ : MIX_UPDATE,
+              live.empty() ? missId : liveId());
+    } else if (roll <
+               mix.readPercent + mix.updatePercent + mix.insertPercent) {
+      w.steps.push_back({MIX_INSERT, (uint32_t)w.inserts.size()});
+      w.inserts.push_back(makeMedicine(freshId(), preload + i));
+    } else if (miss) {
+      addStep(MIX_DELETE, missId);
+    } else {
+      // Remove a stored ID (swap with the last one, so it is O(1))
+      size_t position =
+          uniform_int_distribution<size_t>(0, live.size() - 1)(rng);
+      uint64_t id = live[position];
+      live[position] = live.back();
+      slot[live[position]] = position;
+      live.pop_back();
+      slot.erase(id);
+      addStep(MIX_DELETE, id);
+    }
+  }
+  return w;
+}
+
+#endif
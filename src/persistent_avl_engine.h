@@ -0,0 +1,480 @@
+/*
+ * Name: Lau Su Hui (Abby)
+ * Matric No.: MEC245045
+ * Semester: 20252026-1
+ * Course: MECS1023 ADSA
+ * Group & Theme: Group 1-Pharmacy Inventory Control System
+ * Assignment Title: Medicine Management System (Persistent AVL Engine)
+ */
+
+#ifndef PERSISTENT_AVL_ENGINE_H
+#define PERSISTENT_AVL_ENGINE_H
+
+#include <atomic> // For the published root and the reader epochs
+#include <thread> // For yield (waiting for a free reader slot)
+#include <utility>
+#include <vector>
+
+#include "medicine_common.h"
+
+// This structure represents a "Node" in the Persistent AVL Tree
+// A node is never changed once a root that reaches it has been published;
+// updates build new copies instead. The record lives outside the node, so
+// copying a node never copies the medicine details
+struct PAVLNode {
+  uint64_t key;     // Encoded Batch ID (or STRING_KEY), compared first
+  Medicine *record; // The medicine details (shared by every copy)
+  PAVLNode *left;   // Pointer to left child (smaller Batch ID)
+  PAVLNode *right;  // Pointer to right child (larger Batch ID)
+  int height;       // AVL SPECIFIC: Tracks the height of this node
+  uint64_t version; // Update that created it (only that update may edit it)
+};
+
+// ==========================================
+// PERSISTENT AVL ENGINE (PLUGS INTO MedicineManager)
+// ==========================================
+
+// AVL tree with lock-free snapshot reads for one writer and many readers
+// Logic: An add or delete never edits a published node. It copies the
+// O(log n) nodes on the path to the change (and any node a rotation
+// touches), links the copies to the untouched subtrees, and publishes the
+// new root with one atomic store. A reader that loaded the old root keeps
+// a complete, consistent tree, without taking any lock.
+// Replaced nodes are reclaimed by epochs: each reader announces the
+// update count it started at, and a node replaced by update t is only
+// freed once every active reader started after t.
+// Note: All adds and deletes must come from one thread (the writer); other
+// threads read through snapshot(). Stored records are read-only
+class PersistentAVLEngine {
+public:
+  static const int MAX_READERS = 64; // Snapshots open at the same time
+
+private:
+  // One announced reader: 'epoch' = update count seen at the start
+  // alignas(64): readers on different cores never share a cache line
+  struct alignas(64) ReaderSlot {
+    atomic<bool> claimed{false};
+    atomic<uint64_t> epoch{0}; // 0 = not reading
+  };
+
+  // Upper bound on the tree height (see AVLEngine)
+  static const int MAX_HEIGHT = 96;
+
+  // Retired entries are freed in batches of this many (amortises the scan
+  // of the reader slots)
+  static const size_t RECLAIM_BATCH = 1024;
+
+  atomic<PAVLNode *> root;         // The published root
+  atomic<uint64_t> globalEpoch;    // Updates published so far (+1)
+  ReaderSlot readers[MAX_READERS]; // Announced snapshot readers
+  uint64_t writeVersion;           // Version stamp of the running update
+
+  // Replaced nodes and deleted records, with the epoch they were retired in
+  vector<pair<uint64_t, PAVLNode *>> retiredNodes;
+  vector<pair<uint64_t, Medicine *>> retiredRecords;
+
+  // Three-way comparison of a (key, Batch ID) pair against a node
+  static int compareKey(uint64_t key, string_view batchID,
+                        const PAVLNode *node) {
+    return compareKeys(key, batchID, node->key, node->record->batchID);
+  }
+
+  // Iterative search from any root (used by the writer and by snapshots)
+  static const PAVLNode *searchFrom(const PAVLNode *current, uint64_t key,
+                                    string_view batchID) {
+    while (current != nullptr) {
+      int cmp = compareKey(key, batchID, current);
+      if (cmp == 0) {
+        return current;
+      }
+      current = (cmp < 0) ? current->left : current->right;
+    }
+    return nullptr;
+  }
+
+  // In-order walk from any root with an explicit stack
+  template <class Visit> static void walkFrom(PAVLNode *current, Visit visit) {
+    vector<PAVLNode *> stack;
+    while (current != nullptr || !stack.empty()) {
+      while (current != nullptr) {
+        stack.push_back(current);
+        current = current->left;
+      }
+      current = stack.back();
+      stack.pop_back();
+      visit(*current->record);
+      current = current->right;
+    }
+  }
+
+  // --- NODE VERSIONS ---
+  // A node this update may still edit: itself if this update created it,
+  // otherwise a fresh copy (the original is retired, since the new tree
+  // no longer reaches it)
+  PAVLNode *editable(PAVLNode *n) {
+    if (n->version == writeVersion)
+      return n;
+    PAVLNode *copy = new PAVLNode(*n);
+    copy->version = writeVersion;
+    retiredNodes.push_back({globalEpoch.load(), n});
+    return copy;
+  }
+
+  // --- AVL HELPER FUNCTIONS (BALANCING LOGIC) ---
+  // Same as AVLEngine, except that a rotation first makes the child it
+  // moves editable; 'n' itself is always editable here
+  static int getHeight(const PAVLNode *n) {
+    if (n == nullptr)
+      return 0;
+    return n->height;
+  }
+
+  static int getBalance(const PAVLNode *n) {
+    if (n == nullptr)
+      return 0;
+    return getHeight(n->left) - getHeight(n->right);
+  }
+
+  static void updateHeight(PAVLNode *n) {
+    int leftH = getHeight(n->left);
+    int rightH = getHeight(n->right);
+    n->height = (leftH > rightH ? leftH : rightH) + 1;
+  }
+
+  // Rotation Logic: Right Rotation (Fixes Left-Left Imbalance)
+  PAVLNode *rightRotate(PAVLNode *y) {
+    PAVLNode *x = editable(y->left);
+    y->left = x->right;
+    x->right = y;
+    updateHeight(y);
+    updateHeight(x);
+    return x; // New root of this subtree
+  }
+
+  // Rotation Logic: Left Rotation (Fixes Right-Right Imbalance)
+  PAVLNode *leftRotate(PAVLNode *x) {
+    PAVLNode *y = editable(x->right);
+    x->right = y->left;
+    y->left = x;
+    updateHeight(x);
+    updateHeight(y);
+    return y; // New root of this subtree
+  }
+
+  // Restores the AVL property at one editable node (4 cases)
+  PAVLNode *rebalance(PAVLNode *node) {
+    updateHeight(node);
+    int balance = getBalance(node);
+
+    // Left Left Case
+    if (balance > 1 && getBalance(node->left) >= 0)
+      return rightRotate(node);
+
+    // Left Right Case
+    if (balance > 1 && getBalance(node->left) < 0) {
+      node->left = leftRotate(editable(node->left));
+      return rightRotate(node);
+    }
+
+    // Right Right Case
+    if (balance < -1 && getBalance(node->right) <= 0)
+      return leftRotate(node);
+
+    // Right Left Case
+    if (balance < -1 && getBalance(node->right) > 0) {
+      node->right = rightRotate(editable(node->right));
+      return leftRotate(node);
+    }
+
+    return node;
+  }
+
+  // Copies a recorded search path bottom-up around a new child subtree,
+  // rebalancing every copy, and returns the new root
+  // (path[0] = root ... path[depth - 1] = lowest; wentLeft = direction)
+  PAVLNode *copyPath(PAVLNode **path, const bool *wentLeft, int depth,
+                     PAVLNode *child) {
+    for (int i = depth - 1; i >= 0; i--) {
+      PAVLNode *n = editable(path[i]);
+      if (wentLeft[i]) {
+        n->left = child;
+      } else {
+        n->right = child;
+      }
+      child = rebalance(n);
+    }
+    return child;
+  }
+
+  // --- PUBLISH & RECLAIM ---
+  // Starts an update: nodes stamped with the new version are editable
+  void beginUpdate() { writeVersion++; }
+
+  // Makes the new tree visible to readers, then frees what no reader can
+  // reach any more
+  void publish(PAVLNode *newRoot) {
+    root.store(newRoot);
+    globalEpoch.fetch_add(1);
+    if (retiredNodes.size() + retiredRecords.size() >= RECLAIM_BATCH) {
+      reclaim();
+    }
+  }
+
+  // Frees every retired entry older than the oldest active reader
+  // Logic: A reader announcing epoch E read it after update E - 1 had
+  // published its root, so it can only reach nodes retired at E or later
+  void reclaim() {
+    uint64_t oldest = globalEpoch.load();
+    for (ReaderSlot &slot : readers) {
+      uint64_t e = slot.epoch.load();
+      if (e != 0 && e < oldest)
+        oldest = e;
+    }
+    size_t n = 0;
+    while (n < retiredNodes.size() && retiredNodes[n].first < oldest) {
+      delete retiredNodes[n++].second;
+    }
+    retiredNodes.erase(retiredNodes.begin(), retiredNodes.begin() + n);
+    size_t r = 0;
+    while (r < retiredRecords.size() && retiredRecords[r].first < oldest) {
+      delete retiredRecords[r++].second;
+    }
+    retiredRecords.erase(retiredRecords.begin(), retiredRecords.begin() + r);
+  }
+
+  // Frees a whole tree and its records at once (no reader may hold it)
+  static void deleteTree(PAVLNode *node) {
+    vector<PAVLNode *> stack;
+    if (node != nullptr)
+      stack.push_back(node);
+    while (!stack.empty()) {
+      PAVLNode *current = stack.back();
+      stack.pop_back();
+      if (current->left != nullptr)
+        stack.push_back(current->left);
+      if (current->right != nullptr)
+        stack.push_back(current->right);
+      delete current->record;
+      delete current;
+    }
+  }
+
+public:
+  static constexpr const char *NAME = "Persistent AVL";
+  static constexpr const char *RESULTS_FILE = "persistent_avl_results.txt";
+  static constexpr bool STABLE_RECORDS = true; // Records never move
+  static constexpr bool READ_ONLY_FIND = true; // find() changes nothing
+
+  // A consistent, read-only view of the batches at one moment
+  // It may be used on any thread while the writer keeps updating; the
+  // records it returns stay valid until the snapshot is destroyed
+  class Snapshot {
+  private:
+    ReaderSlot *slot;
+    PAVLNode *top;
+    bool encodedKeys;
+
+    friend class PersistentAVLEngine;
+
+    // Claims a reader slot, announces the current epoch, then loads the
+    // root (in this order, so the writer sees the reader before it could
+    // free anything the root reaches)
+    Snapshot(PersistentAVLEngine &owner, bool useEncodedKeys)
+        : slot(nullptr), encodedKeys(useEncodedKeys) {
+      while (slot == nullptr) {
+        for (ReaderSlot &s : owner.readers) {
+          bool expected = false;
+          if (s.claimed.compare_exchange_strong(expected, true)) {
+            slot = &s;
+            break;
+          }
+        }
+        if (slot == nullptr)
+          this_thread::yield(); // All slots busy: wait for a reader to end
+      }
+      slot->epoch.store(owner.globalEpoch.load());
+      top = owner.root.load();
+    }
+
+  public:
+    Snapshot(Snapshot &&other) noexcept
+        : slot(other.slot), top(other.top), encodedKeys(other.encodedKeys) {
+      other.slot = nullptr;
+    }
+    Snapshot(const Snapshot &) = delete;
+    Snapshot &operator=(const Snapshot &) = delete;
+    Snapshot &operator=(Snapshot &&) = delete;
+
+    ~Snapshot() {
+      if (slot != nullptr) {
+        slot->epoch.store(0);
+        slot->claimed.store(false);
+      }
+    }
+
+    // Search in this version of the tree
+    const Medicine *find(string_view batchID) const {
+      uint64_t key = encodedKeys ? encodeBatchID(batchID) : STRING_KEY;
+      const PAVLNode *node = searchFrom(top, key, batchID);
+      return (node != nullptr) ? node->record : nullptr;
+    }
+
+    // In-Order Traversal of this version: calls visit(const Medicine &)
+    template <class Visit> void forEach(Visit visit) const {
+      walkFrom(top, [&visit](const Medicine &med) { visit(med); });
+    }
+
+    bool empty() const { return top == nullptr; }
+  };
+
+  PersistentAVLEngine() : root(nullptr), globalEpoch(1), writeVersion(0) {}
+  PersistentAVLEngine(const PersistentAVLEngine &) = delete;
+  PersistentAVLEngine &operator=(const PersistentAVLEngine &) = delete;
+
+  // Note: No snapshot may outlive the engine
+  ~PersistentAVLEngine() {
+    deleteTree(root.load());
+    for (auto &entry : retiredNodes) {
+      delete entry.second;
+    }
+    for (auto &entry : retiredRecords) {
+      delete entry.second;
+    }
+  }
+
+  // --- CORE OPERATIONS: INSERT, SEARCH, DELETE (WRITER THREAD) ---
+
+  // Path-copying insert AND rebalance; the record is moved into the heap
+  // Returns the stored record, or nullptr (record untouched) if the Batch ID
+  // already exists
+  Medicine *insert(uint64_t key, Medicine &med) {
+    // 1. Standard BST descent, remembering every ancestor and direction
+    PAVLNode *path[MAX_HEIGHT];
+    bool wentLeft[MAX_HEIGHT];
+    int depth = 0;
+    PAVLNode *current = root.load(memory_order_relaxed);
+    while (current != nullptr) {
+      int cmp = compareKey(key, med.batchID, current);
+      if (cmp == 0)
+        return nullptr; // Duplicate Case: No duplicates allowed
+      path[depth] = current;
+      wentLeft[depth++] = cmp < 0;
+      current = (cmp < 0) ? current->left : current->right;
+    }
+
+    // 2. New leaf, then copies of its ancestors up to a new root
+    beginUpdate();
+    Medicine *record = new Medicine(std::move(med));
+    PAVLNode *leaf =
+        new PAVLNode{key, record, nullptr, nullptr, 1, writeVersion};
+    publish(copyPath(path, wentLeft, depth, leaf));
+    return record;
+  }
+
+  // Search in the current tree (writer thread only; others use snapshot())
+  Medicine *find(uint64_t key, string_view batchID) {
+    const PAVLNode *node =
+        searchFrom(root.load(memory_order_relaxed), key, batchID);
+    return (node != nullptr) ? node->record : nullptr;
+  }
+
+  // Sets the quantity of a stored batch
+  // Open snapshots share the stored record, so it is never written in
+  // place: the batch is removed and added again as a new record
+  // Returns the new record, or nullptr if the Batch ID is not stored
+  Medicine *updateQuantity(uint64_t key, string_view batchID, int quantity) {
+    Medicine *stored = find(key, batchID);
+    if (stored == nullptr)
+      return nullptr;
+    Medicine med = *stored; // 'batchID' may point into the old record
+    med.quantity = quantity;
+    remove(key, med.batchID);
+    return insert(key, med);
+  }
+
+  // Path-copying delete AND rebalance
+  bool remove(uint64_t key, string_view batchID) {
+    // 1. Find the node, remembering every ancestor and direction
+    PAVLNode *path[MAX_HEIGHT];
+    bool wentLeft[MAX_HEIGHT];
+    int depth = 0;
+    PAVLNode *target = root.load(memory_order_relaxed);
+    while (target != nullptr) {
+      int cmp = compareKey(key, batchID, target);
+      if (cmp == 0)
+        break;
+      path[depth] = target;
+      wentLeft[depth++] = cmp < 0;
+      target = (cmp < 0) ? target->left : target->right;
+    }
+    if (target == nullptr)
+      return false;
+
+    beginUpdate();
+    uint64_t epoch = globalEpoch.load();
+    retiredRecords.push_back({epoch, target->record});
+    PAVLNode *child;
+    if ((target->left == nullptr) || (target->right == nullptr)) {
+      // Zero or one child: the child subtree is reused as it is
+      retiredNodes.push_back({epoch, target});
+      child = target->left ? target->left : target->right;
+    } else {
+      // Two children: a copy of the node takes the In-Order Successor's
+      // key and record, and the successor is cut out of the right subtree
+      PAVLNode *replacement = editable(target);
+      int slot = depth++;
+      wentLeft[slot] = false;
+      PAVLNode *successor = target->right;
+      while (successor->left != nullptr) {
+        path[depth] = successor;
+        wentLeft[depth++] = true;
+        successor = successor->left;
+      }
+      replacement->key = successor->key;
+      replacement->record = successor->record;
+      path[slot] = replacement;
+      retiredNodes.push_back({epoch, successor});
+      child = successor->right;
+    }
+
+    // 2. Copy and rebalance the path up to a new root
+    publish(copyPath(path, wentLeft, depth, child));
+    return true;
+  }
+
+  // In-Order Traversal: calls visit(Medicine &) in Batch ID order
+  template <class Visit> void forEach(Visit visit) {
+    walkFrom(root.load(memory_order_relaxed), visit);
+  }
+
+  // Empties the whole tree (readers keep the version they hold)
+  void clear() {
+    PAVLNode *old = root.load(memory_order_relaxed);
+    if (old == nullptr)
+      return;
+    uint64_t epoch = globalEpoch.load();
+    vector<PAVLNode *> stack{old};
+    while (!stack.empty()) {
+      PAVLNode *current = stack.back();
+      stack.pop_back();
+      if (current->left != nullptr)
+        stack.push_back(current->left);
+      if (current->right != nullptr)
+        stack.push_back(current->right);
+      retiredRecords.push_back({epoch, current->record});
+      retiredNodes.push_back({epoch, current});
+    }
+    publish(nullptr);
+  }
+
+  bool empty() const { return root.load(memory_order_relaxed) == nullptr; }
+
+  // --- OPTIONAL EXTRAS ---
+  // Number of levels from the root down to the deepest leaf
+  int height() { return getHeight(root.load(memory_order_relaxed)); }
+
+  // Opens a lock-free read view of the current version (any thread)
+  Snapshot snapshot(bool encodedKeys) { return Snapshot(*this, encodedKeys); }
+};
+
+#endif
@@ -0,0 +1,313 @@
+/*
+ * Name: Lau Su Hui (Abby)
+ * Matric No.: MEC245045
+ * Semester: 20252026-1
+ * Course: MECS1023 ADSA
+ * Group & Theme: Group 1-Pharmacy Inventory Control System
+ * Assignment Title: Medicine Management System (Red-Black Tree Engine)
+ */
+
+#ifndef RB_ENGINE_H
+#define RB_ENGINE_H
+
+#include "tree_nodes.h"
+
+// This structure represents a "Node" in the Red-Black Tree
+struct RBNode {
+  uint64_t key;   // Encoded Batch ID (or STRING_KEY), compared first
+  Medicine data;  // The medicine details
+  RBNode *left;   // Pointer to left child (smaller Batch ID)
+  RBNode *right;  // Pointer to right child (larger Batch ID)
+  RBNode *parent; // Pointer to parent (nullptr at the root)
+  bool red;       // RB SPECIFIC: Node colour (missing children count as black)
+
+  // Constructor to initialise a detached red node
+  // The record is moved in, so its strings are never deep-copied
+  RBNode(Medicine &&med, uint64_t code) : data(std::move(med)) { init(code); }
+
+  void init(uint64_t code) {
+    key = code;
+    left = nullptr;
+    right = nullptr;
+    parent = nullptr;
+    red = true; // New nodes are always inserted red
+  }
+};
+
+// ==========================================
+// RED-BLACK ENGINE (PLUGS INTO MedicineManager)
+// ==========================================
+
+// Rules: the root is black, a red node has no red child, and every path
+// from a node down to a missing child passes the same number of black
+// nodes. The tree is at most 2 * log2(n + 1) high, looser than AVL, but an
+// insert needs at most 2 rotations and a delete at most 3.
+class RBEngine : public LinkedTreeEngine<RBEngine, RBNode> {
+private:
+  // Three-way comparison of a (key, Batch ID) pair against a node
+  static int compareKey(uint64_t key, string_view batchID, const RBNode *node) {
+    return compareKeys(key, batchID, node->key, node->data.batchID);
+  }
+
+  static bool isRed(const RBNode *n) { return n != nullptr && n->red; }
+
+  // Helper to point a parent (or the root) at a new child subtree
+  void replaceChild(RBNode *parent, RBNode *oldChild, RBNode *newChild) {
+    if (parent == nullptr) {
+      root = newChild;
+    } else if (parent->left == oldChild) {
+      parent->left = newChild;
+    } else {
+      parent->right = newChild;
+    }
+  }
+
+  // Rotation Logic: x's right child takes x's place, x becomes its left
+  void rotateLeft(RBNode *x) {
+    RBNode *y = x->right;
+    x->right = y->left;
+    if (y->left != nullptr)
+      y->left->parent = x;
+    y->parent = x->parent;
+    replaceChild(x->parent, x, y);
+    y->left = x;
+    x->parent = y;
+  }
+
+  // Rotation Logic: x's left child takes x's place, x becomes its right
+  void rotateRight(RBNode *x) {
+    RBNode *y = x->left;
+    x->left = y->right;
+    if (y->right != nullptr)
+      y->right->parent = x;
+    y->parent = x->parent;
+    replaceChild(x->parent, x, y);
+    y->right = x;
+    x->parent = y;
+  }
+
+  // Helper to repair a red node with a red parent after an insert
+  // Case 1: Red uncle -> recolour and continue at the grandparent
+  // Case 2: Black uncle, "inner" child -> rotate it to the outside
+  // Case 3: Black uncle, "outer" child -> rotate the grandparent, recolour
+  void insertFixup(RBNode *z) {
+    while (isRed(z->parent)) {
+      RBNode *p = z->parent;
+      RBNode *g = p->parent; // Exists: a red parent is never the root
+      if (p == g->left) {
+        RBNode *uncle = g->right;
+        if (isRed(uncle)) {
+          p->red = false;
+          uncle->red = false;
+          g->red = true;
+          z = g;
+        } else {
+          if (z == p->right) {
+            z = p;
+            rotateLeft(z);
+            p = z->parent;
+          }
+          p->red = false;
+          g->red = true;
+          rotateRight(g);
+        }
+      } else {
+        RBNode *uncle = g->left;
+        if (isRed(uncle)) {
+          p->red = false;
+          uncle->red = false;
+          g->red = true;
+          z = g;
+        } else {
+          if (z == p->left) {
+            z = p;
+            rotateRight(z);
+            p = z->parent;
+          }
+          p->red = false;
+          g->red = true;
+          rotateLeft(g);
+        }
+      }
+    }
+    root->red = false;
+  }
+
+  // Helper to repair the missing black on x's side after a delete
+  // x may be nullptr, so its parent is passed alongside
+  void deleteFixup(RBNode *x, RBNode *parent) {
+    while (x != root && !isRed(x)) {
+      if (x == parent->left) {
+        RBNode *w = parent->right; // Sibling: never missing here
+        if (isRed(w)) {
+          w->red = false;
+          parent->red = true;
+          rotateLeft(parent);
+          w = parent->right;
+        }
+        if (!isRed(w->left) && !isRed(w->right)) {
+          w->red = true;
+          x = parent;
+          parent = x->parent;
+        } else {
+          if (!isRed(w->right)) {
+            w->left->red = false;
+            w->red = true;
+            rotateRight(w);
+            w = parent->right;
+          }
+          w->red = parent->red;
+          parent->red = false;
+          w->right->red = false;
+          rotateLeft(parent);
+          x = root;
+        }
+      } else {
+        RBNode *w = parent->left;
+        if (isRed(w)) {
+          w->red = false;
+          parent->red = true;
+          rotateRight(parent);
+          w = parent->left;
+        }
+        if (!isRed(w->left) && !isRed(w->right)) {
+          w->red = true;
+          x = parent;
+          parent = x->parent;
+        } else {
+          if (!isRed(w->left)) {
+            w->right->red = false;
+            w->red = true;
+            rotateLeft(w);
+            w = parent->left;
+          }
+          w->red = parent->red;
+          parent->red = false;
+          w->left->red = false;
+          rotateRight(parent);
+          x = root;
+        }
+      }
+    }
+    if (x != nullptr)
+      x->red = false;
+  }
+
+  // Helper to put subtree v where subtree u was
+  void transplant(RBNode *u, RBNode *v) {
+    replaceChild(u->parent, u, v);
+    if (v != nullptr)
+      v->parent = u->parent;
+  }
+
+public:
+  static constexpr const char *NAME = "Red-Black";
+  static constexpr const char *RESULTS_FILE = "rb_results.txt";
+  static constexpr bool STABLE_RECORDS = true; // Nodes never move
+  static constexpr bool READ_ONLY_FIND = true; // find() changes nothing
+
+  // --- CORE OPERATIONS: INSERT, SEARCH, DELETE ---
+  // Parent pointers let the fixups walk upwards without a path array
+
+  // Iterative insert; the record is only moved into the new node
+  // Returns the stored record, or nullptr (record untouched) if the Batch ID
+  // already exists
+  Medicine *insert(uint64_t key, Medicine &med) {
+    RBNode *parent = nullptr;
+    RBNode *current = root;
+    int cmp = 0;
+    while (current != nullptr) {
+      cmp = compareKey(key, med.batchID, current);
+      if (cmp == 0)
+        return nullptr; // Duplicate Case: Batch ID already exists
+      parent = current;
+      current = (cmp < 0) ? current->left : current->right;
+    }
+
+    RBNode *node = createNode(std::move(med), key);
+    node->parent = parent;
+    if (parent == nullptr) {
+      root = node;
+    } else if (cmp < 0) {
+      parent->left = node;
+    } else {
+      parent->right = node;
+    }
+    insertFixup(node);
+    return &node->data;
+  }
+
+  // Iterative search
+  Medicine *find(uint64_t key, string_view batchID) {
+    RBNode *current = root;
+    while (current != nullptr) {
+      int cmp = compareKey(key, batchID, current);
+      if (cmp == 0)
+        return &current->data;
+      current = (cmp < 0) ? current->left : current->right;
+    }
+    return nullptr;
+  }
+
+  // Iterative delete; nodes are relinked, so no record is ever copied
+  bool remove(uint64_t key, string_view batchID) {
+    RBNode *z = root;
+    while (z != nullptr) {
+      int cmp = compareKey(key, batchID, z);
+      if (cmp == 0)
+        break;
+      z = (cmp < 0) ? z->left : z->right;
+    }
+    if (z == nullptr)
+      return false;
+
+    // x = the subtree that moves into the removed position
+    bool removedRed = z->red;
+    RBNode *x;
+    RBNode *xParent;
+    if (z->left == nullptr) {
+      x = z->right;
+      xParent = z->parent;
+      transplant(z, z->right);
+    } else if (z->right == nullptr) {
+      x = z->left;
+      xParent = z->parent;
+      transplant(z, z->left);
+    } else {
+      // Two children: the In-Order Successor takes z's place and colour
+      RBNode *y = z->right;
+      while (y->left != nullptr) {
+        y = y->left;
+      }
+      removedRed = y->red;
+      x = y->right;
+      if (y->parent == z) {
+        xParent = y;
+      } else {
+        xParent = y->parent;
+        transplant(y, y->right);
+        y->right = z->right;
+        y->right->parent = y;
+      }
+      transplant(z, y);
+      y->left = z->left;
+      y->left->parent = y;
+      y->red = z->red;
+    }
+    destroyNode(z);
+
+    // Removing a black node leaves one path a black short
+    if (!removedRed)
+      deleteFixup(x, xParent);
+    return true;
+  }
+
+  // forEach, clear, empty, reduce, setPoolEnabled and the ordered
+  // iterators come from LinkedTreeEngine (tree_nodes.h)
+
+  // --- OPTIONAL EXTRAS ---
+  // Number of levels from the root down to the deepest leaf
+  int height() { return subtreeHeight(root); }
+};
+
+#endif
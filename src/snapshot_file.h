@@ -0,0 +1,303 @@
+/*
+ * Name: Lau Su Hui (Abby)
+ * Matric No.: MEC245045
+ * Semester: 20252026-1
+ * Course: MECS1023 ADSA
+ * Group & Theme: Group 1-Pharmacy Inventory Control System
+ * Assignment Title: Medicine Management System (Binary Snapshot File)
+ */
+
+#ifndef SNAPSHOT_FILE_H
+#define SNAPSHOT_FILE_H
+
+#include <cstdio>  // For rename (replace the old snapshot in one step)
+#include <cstring> // For memcpy, memcmp (raw header and record bytes)
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "medicine_common.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>    // For open
+#include <sys/mman.h> // For mmap (map the snapshot instead of reading it)
+#include <sys/stat.h> // For fstat (file size)
+#include <unistd.h>   // For close, fsync
+#define HAVE_POSIX_FILES 1
+#endif
+
+// ==========================================
+// BINARY SNAPSHOT FILE (FAST STARTUP)
+// ==========================================
+
+// Layout (little-endian, as written by the host):
+//   SnapshotHeader                  magic, version, counts, checksum
+//   SnapshotRecord[recordCount]     fixed width, in Batch ID order
+//   char heap[heapSize]             the strings of every record, back to back
+// Each record points at its four strings in the heap (Batch ID, name,
+// expiry date, location, in that order), so the records themselves can be
+// checked and decoded without scanning for separators.
+const char SNAPSHOT_MAGIC[8] = {'M', 'E', 'D', 'S', 'N', 'A', 'P', '\0'};
+const uint32_t SNAPSHOT_VERSION = 1; // Bump on any layout change
+
+struct SnapshotHeader {
+  char magic[8];        // SNAPSHOT_MAGIC
+  uint32_t version;     // SNAPSHOT_VERSION
+  uint32_t recordSize;  // sizeof(SnapshotRecord) when written
+  uint64_t recordCount; // Batches in the file
+  uint64_t heapSize;    // Bytes of string data after the records
+  uint64_t checksum;    // snapshotChecksum of records + heap
+  uint64_t reserved;    // Always 0 (room for flags)
+};
+
+struct SnapshotRecord {
+  int32_t quantity;        // Physical stock count
+  uint32_t idLength;       // Batch ID bytes
+  uint32_t nameLength;     // Medicine name bytes
+  uint32_t expiryLength;   // Expiry date bytes
+  uint32_t locationLength; // Location bytes
+  uint32_t reserved;       // Always 0 (keeps heapOffset 8-byte aligned)
+  uint64_t heapOffset;     // Where this record's strings start in the heap
+};
+
+static_assert(sizeof(SnapshotHeader) == 48, "snapshot header layout");
+static_assert(sizeof(SnapshotRecord) == 32, "snapshot record layout");
+
+// 64-bit checksum of a byte range (FNV-1a over 8-byte words)
+// Catches truncated, torn and bit-flipped files; it is not a secure hash
+inline uint64_t snapshotChecksum(const char *data, size_t size,
+                                 uint64_t h = 0xCBF29CE484222325ULL) {
+  const uint64_t PRIME = 0x100000001B3ULL;
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    uint64_t word;
+    memcpy(&word, data + i, 8);
+    h = (h ^ word) * PRIME;
+  }
+  for (; i < size; i++) {
+    h = (h ^ (unsigned char)data[i]) * PRIME;
+  }
+  return h ^ (h >> 32);
+}
+
+// Forces a written file's data onto the disk (fsync), so it survives a
+// power cut; returns false if that failed (a no-op without POSIX files)
+inline bool syncFile(const string &path) {
+#ifdef HAVE_POSIX_FILES
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+  bool synced = fsync(fd) == 0;
+  ::close(fd);
+  return synced;
+#else
+  (void)path;
+  return true;
+#endif
+}
+
+// Builds a snapshot in memory: add() every batch in Batch ID order, then
+// write() it out
+class SnapshotWriter {
+private:
+  vector<SnapshotRecord> records;
+  string heap;
+
+public:
+  void add(const Medicine &med) {
+    SnapshotRecord r;
+    r.quantity = med.quantity;
+    r.idLength = (uint32_t)med.batchID.size();
+    r.nameLength = (uint32_t)med.medicineName.size();
+    r.expiryLength = (uint32_t)med.expiryDate.size();
+    r.locationLength = (uint32_t)med.location.size();
+    r.reserved = 0;
+    r.heapOffset = heap.size();
+    records.push_back(r);
+    heap.append(med.batchID);
+    heap.append(med.medicineName);
+    heap.append(med.expiryDate);
+    heap.append(med.location);
+  }
+
+  size_t size() const { return records.size(); }
+
+  // Writes the file next to 'path' first, syncs it and then renames it over
+  // 'path', so a crash mid-write never leaves a half-written snapshot behind
+  // Returns false if the file could not be written
+  bool write(const string &path) const {
+    SnapshotHeader header;
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.recordSize = sizeof(SnapshotRecord);
+    header.recordCount = records.size();
+    header.heapSize = heap.size();
+    header.checksum = snapshotChecksum(
+        heap.data(), heap.size(),
+        snapshotChecksum((const char *)records.data(),
+                         records.size() * sizeof(SnapshotRecord)));
+    header.reserved = 0;
+
+    string temp = path + ".tmp";
+    {
+      ofstream out(temp, ios::binary | ios::trunc);
+      out.write((const char *)&header, sizeof(header));
+      out.write((const char *)records.data(),
+                records.size() * sizeof(SnapshotRecord));
+      out.write(heap.data(), heap.size());
+      if (!out.good())
+        return false;
+    }
+    return syncFile(temp) && rename(temp.c_str(), path.c_str()) == 0;
+  }
+};
+
+// A whole file, read-only, mapped into memory (or read in where mmap is
+// not available); the bytes stay valid until the object is destroyed
+class MappedFile {
+private:
+  const char *bytes;
+  size_t length;
+#ifndef HAVE_POSIX_FILES
+  vector<char> buffer;
+#endif
+
+public:
+  MappedFile() : bytes(nullptr), length(0) {}
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+  ~MappedFile() { close(); }
+
+  // Returns false if the file does not exist or cannot be read
+  bool open(const string &path) {
+    close();
+#ifdef HAVE_POSIX_FILES
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+      return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+      ::close(fd);
+      return false;
+    }
+    length = (size_t)info.st_size;
+    if (length > 0) {
+      void *p = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (p == MAP_FAILED) {
+        ::close(fd);
+        length = 0;
+        return false;
+      }
+      madvise(p, length, MADV_SEQUENTIAL); // Read once, front to back
+      bytes = (const char *)p;
+    }
+    ::close(fd); // The mapping stays valid without the descriptor
+    return true;
+#else
+    ifstream in(path, ios::binary | ios::ate);
+    if (!in)
+      return false;
+    buffer.resize((size_t)in.tellg());
+    in.seekg(0);
+    in.read(buffer.data(), buffer.size());
+    bytes = buffer.data();
+    length = buffer.size();
+    return in.good();
+#endif
+  }
+
+  void close() {
+#ifdef HAVE_POSIX_FILES
+    if (bytes != nullptr)
+      munmap((void *)bytes, length);
+#else
+    buffer.clear();
+#endif
+    bytes = nullptr;
+    length = 0;
+  }
+
+  const char *data() const { return bytes; }
+  size_t size() const { return length; }
+};
+
+// Checks a mapped snapshot and decodes record i into a Medicine
+// Every check runs before any record is decoded, so a bad file is
+// rejected as a whole
+class SnapshotReader {
+private:
+  size_t count;        // Records in the file
+  const char *records; // The record array inside the mapped file
+  const char *heap;    // The string heap inside the mapped file
+
+public:
+  SnapshotReader() : count(0), records(nullptr), heap(nullptr) {}
+
+  // Returns false (with the reason in 'error') if the bytes are not a
+  // complete, uncorrupted snapshot of this version
+  bool open(const MappedFile &file, string &error) {
+    SnapshotHeader h;
+    if (file.size() < sizeof(h)) {
+      error = "file too short";
+      return false;
+    }
+    memcpy(&h, file.data(), sizeof(h));
+    if (memcmp(h.magic, SNAPSHOT_MAGIC, sizeof(h.magic)) != 0) {
+      error = "not a snapshot file";
+      return false;
+    }
+    if (h.version != SNAPSHOT_VERSION ||
+        h.recordSize != sizeof(SnapshotRecord)) {
+      error = "unsupported snapshot version " + to_string(h.version);
+      return false;
+    }
+    size_t body = file.size() - sizeof(h);
+    if (h.recordCount > body / sizeof(SnapshotRecord) ||
+        h.heapSize != body - h.recordCount * sizeof(SnapshotRecord)) {
+      error = "file size does not match its header (truncated?)";
+      return false;
+    }
+    size_t recordBytesSize = h.recordCount * sizeof(SnapshotRecord);
+    const char *recordBytes = file.data() + sizeof(h);
+    const char *heapBytes = recordBytes + recordBytesSize;
+    uint64_t sum = snapshotChecksum(
+        heapBytes, h.heapSize, snapshotChecksum(recordBytes, recordBytesSize));
+    if (sum != h.checksum) {
+      error = "checksum mismatch (corrupted file)";
+      return false;
+    }
+    for (uint64_t i = 0; i < h.recordCount; i++) {
+      SnapshotRecord r;
+      memcpy(&r, recordBytes + i * sizeof(r), sizeof(r));
+      uint64_t end = r.heapOffset + (uint64_t)r.idLength + r.nameLength +
+                     r.expiryLength + r.locationLength;
+      if (r.heapOffset > h.heapSize || end > h.heapSize) {
+        error = "record " + to_string(i) + " points outside the file";
+        return false;
+      }
+    }
+    count = h.recordCount;
+    records = recordBytes;
+    heap = heapBytes;
+    return true;
+  }
+
+  size_t size() const { return count; }
+
+  // Copies record i out of the file (only after a successful open)
+  void decode(size_t i, Medicine &med) const {
+    SnapshotRecord r;
+    memcpy(&r, records + i * sizeof(r), sizeof(r));
+    const char *s = heap + r.heapOffset;
+    med.batchID.assign(s, r.idLength);
+    s += r.idLength;
+    med.medicineName.assign(s, r.nameLength);
+    s += r.nameLength;
+    med.expiryDate.assign(s, r.expiryLength);
+    s += r.expiryLength;
+    med.location.assign(s, r.locationLength);
+    med.quantity = r.quantity;
+  }
+};
+
+#endif
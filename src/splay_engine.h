@@ -0,0 +1,179 @@
+/*
+ * Name: Lau Su Hui (Abby)
+ * Matric No.: MEC245045
+ * Semester: 20252026-1
+ * Course: MECS1023 ADSA
+ * Group & Theme: Group 1-Pharmacy Inventory Control System
+ * Assignment Title: Medicine Management System (Splay Tree Engine)
+ */
+
+#ifndef SPLAY_ENGINE_H
+#define SPLAY_ENGINE_H
+
+#include "tree_nodes.h"
+
+// This structure represents a "Node" in the Splay Tree
+struct SplayNode {
+  uint64_t key;     // Encoded Batch ID (or STRING_KEY), compared first
+  Medicine data;    // The medicine details
+  SplayNode *left;  // Pointer to left child (smaller Batch ID)
+  SplayNode *right; // Pointer to right child (larger Batch ID)
+
+  // Constructor to initialise a node with data and null pointers
+  // The record is moved in, so its strings are never deep-copied
+  SplayNode(Medicine &&med, uint64_t code) : data(std::move(med)) {
+    init(code);
+  }
+
+  void init(uint64_t code) {
+    key = code;
+    left = nullptr;
+    right = nullptr;
+  }
+};
+
+// ==========================================
+// SPLAY ENGINE (PLUGS INTO MedicineManager)
+// ==========================================
+
+// Self-adjusting BST: every access moves the batch it reached to the root.
+// No balance is stored, but any sequence of m operations costs
+// O(m log n) in total, and frequently requested batches stay near the
+// top, so skewed counter traffic (a few fast movers) gets short paths.
+// Note: Searches restructure the tree, so they also invalidate iterators
+class SplayEngine : public LinkedTreeEngine<SplayEngine, SplayNode> {
+private:
+  // Three-way comparison of a (key, Batch ID) pair against a node
+  static int compareKey(uint64_t key, string_view batchID,
+                        const SplayNode *node) {
+    return compareKeys(key, batchID, node->key, node->data.batchID);
+  }
+
+  // Top-down splay: brings the batch (or the last node on its search path)
+  // to the root in one pass down, without recursion or parent pointers
+  // Logic: Nodes left of the path are hung onto a "left tree", nodes right
+  // of it onto a "right tree"; two steps the same way rotate first
+  // (zig-zig), which roughly halves the depth of the whole path
+  void splay(uint64_t key, string_view batchID) {
+    SplayNode *leftRoot = nullptr;  // Everything smaller than the target
+    SplayNode *rightRoot = nullptr; // Everything larger than the target
+    SplayNode **leftHook = &leftRoot;   // Right link of the left tree's max
+    SplayNode **rightHook = &rightRoot; // Left link of the right tree's min
+    SplayNode *t = root;
+    while (true) {
+      int cmp = compareKey(key, batchID, t);
+      if (cmp < 0) {
+        if (t->left == nullptr)
+          break;
+        if (compareKey(key, batchID, t->left) < 0) {
+          SplayNode *y = t->left; // Zig-zig: Right Rotation first
+          t->left = y->right;
+          y->right = t;
+          t = y;
+          if (t->left == nullptr)
+            break;
+        }
+        *rightHook = t; // Link t into the right tree
+        rightHook = &t->left;
+        t = t->left;
+      } else if (cmp > 0) {
+        if (t->right == nullptr)
+          break;
+        if (compareKey(key, batchID, t->right) > 0) {
+          SplayNode *y = t->right; // Zig-zig: Left Rotation first
+          t->right = y->left;
+          y->left = t;
+          t = y;
+          if (t->right == nullptr)
+            break;
+        }
+        *leftHook = t; // Link t into the left tree
+        leftHook = &t->right;
+        t = t->right;
+      } else {
+        break;
+      }
+    }
+    // Reassemble: t's subtrees go to the side trees, which become its own
+    *leftHook = t->left;
+    *rightHook = t->right;
+    t->left = leftRoot;
+    t->right = rightRoot;
+    root = t;
+  }
+
+public:
+  static constexpr const char *NAME = "Splay";
+  static constexpr const char *RESULTS_FILE = "splay_results.txt";
+  static constexpr bool STABLE_RECORDS = true; // Nodes never move
+  static constexpr bool READ_ONLY_FIND = false; // find() splays the tree
+
+  // --- CORE OPERATIONS: INSERT, SEARCH, DELETE ---
+
+  // Insert: splay the ID's neighbour to the root, then split the tree
+  // around the new node, which becomes the root
+  // Returns the stored record, or nullptr (record untouched) if the Batch ID
+  // already exists
+  Medicine *insert(uint64_t key, Medicine &med) {
+    if (root == nullptr) {
+      root = createNode(std::move(med), key);
+      return &root->data;
+    }
+    splay(key, med.batchID);
+    int cmp = compareKey(key, med.batchID, root);
+    if (cmp == 0)
+      return nullptr; // Duplicate Case: Batch ID already exists
+
+    SplayNode *node = createNode(std::move(med), key);
+    if (cmp < 0) {
+      node->left = root->left;
+      node->right = root;
+      root->left = nullptr;
+    } else {
+      node->right = root->right;
+      node->left = root;
+      root->right = nullptr;
+    }
+    root = node;
+    return &node->data;
+  }
+
+  // Search: the batch found (or its nearest neighbour) becomes the root
+  Medicine *find(uint64_t key, string_view batchID) {
+    if (root == nullptr)
+      return nullptr;
+    splay(key, batchID);
+    return (compareKey(key, batchID, root) == 0) ? &root->data : nullptr;
+  }
+
+  // Delete: splay the batch to the root, then join its two subtrees by
+  // splaying the left one's maximum up (it has no right child after that)
+  bool remove(uint64_t key, string_view batchID) {
+    if (root == nullptr)
+      return false;
+    splay(key, batchID);
+    if (compareKey(key, batchID, root) != 0)
+      return false;
+
+    SplayNode *target = root;
+    if (target->left == nullptr) {
+      root = target->right;
+    } else {
+      root = target->left;
+      splay(key, batchID); // Every key on the left is smaller: max rises
+      root->right = target->right;
+    }
+    destroyNode(target);
+    return true;
+  }
+
+  // forEach, clear, empty, reduce, setPoolEnabled and the ordered
+  // iterators (whose bounds do not splay) come from LinkedTreeEngine
+  // (tree_nodes.h)
+
+  // --- OPTIONAL EXTRAS ---
+  // Number of levels from the root down to the deepest leaf
+  int height() { return subtreeHeight(root); }
+};
+
+#endif
@@ -0,0 +1,153 @@
+/*
+ * Name: Lau Su Hui (Abby)
+ * Matric No.: MEC245045
+ * Semester: 20252026-1
+ * Course: MECS1023 ADSA
+ * Group & Theme: Group 1-Pharmacy Inventory Control System
+ * Assignment Title: Medicine Management System (Standard Library Baselines)
+ */
+
+#ifndef STD_MAP_ENGINES_H
+#define STD_MAP_ENGINES_H
+
+#include <algorithm> // For sort (ordered display of the hash map)
+#include <map>
+#include <unordered_map>
+#include <utility> // For move (zero-copy insertion)
+
+#include "medicine_common.h"
+
+// Baselines for the engine benchmark: the same MedicineManager interface on
+// top of the standard library's red-black tree (std::map) and hash table
+// (std::unordered_map)
+
+// ==========================================
+// std::map ENGINE
+// ==========================================
+
+class MapEngine {
+private:
+  // Map key: the packed key plus the Batch ID text (for STRING_KEY ties)
+  struct BatchKey {
+    uint64_t key;
+    string batchID;
+  };
+
+  // Lookup key that borrows the caller's Batch ID (no string is built)
+  struct BatchKeyRef {
+    uint64_t key;
+    string_view batchID;
+  };
+
+  // Orders both key kinds the same way as every other engine
+  struct KeyLess {
+    typedef void is_transparent; // Allows find() with a BatchKeyRef
+    template <class A, class B> bool operator()(const A &a, const B &b) const {
+      return compareKeys(a.key, a.batchID, b.key, b.batchID) < 0;
+    }
+  };
+
+  map<BatchKey, Medicine, KeyLess> records;
+
+public:
+  static constexpr const char *NAME = "std::map";
+  static constexpr const char *RESULTS_FILE = "map_results.txt";
+  static constexpr bool STABLE_RECORDS = true; // Nodes never move
+  static constexpr bool READ_ONLY_FIND = true; // find() changes nothing
+
+  // Returns the stored record, or nullptr (record untouched) if the Batch ID
+  // already exists
+  Medicine *insert(uint64_t key, Medicine &med) {
+    auto result =
+        records.try_emplace(BatchKey{key, med.batchID}, std::move(med));
+    return result.second ? &result.first->second : nullptr;
+  }
+
+  Medicine *find(uint64_t key, string_view batchID) {
+    auto it = records.find(BatchKeyRef{key, batchID});
+    return (it != records.end()) ? &it->second : nullptr;
+  }
+
+  bool remove(uint64_t key, string_view batchID) {
+    auto it = records.find(BatchKeyRef{key, batchID});
+    if (it == records.end())
+      return false;
+    records.erase(it);
+    return true;
+  }
+
+  // Calls visit(Medicine &) in Batch ID order
+  template <class Visit> void forEach(Visit visit) {
+    for (auto &entry : records) {
+      visit(entry.second);
+    }
+  }
+
+  void clear() { records.clear(); }
+  bool empty() const { return records.empty(); }
+};
+
+// ==========================================
+// std::unordered_map ENGINE
+// ==========================================
+
+class HashMapEngine {
+private:
+  // The packed key is kept next to the record for the ordered display
+  struct Entry {
+    uint64_t key;
+    Medicine data;
+  };
+
+  unordered_map<string, Entry> records;
+
+public:
+  static constexpr const char *NAME = "std::unordered_map";
+  static constexpr const char *RESULTS_FILE = "hashmap_results.txt";
+  static constexpr bool STABLE_RECORDS = true; // Nodes never move
+  static constexpr bool READ_ONLY_FIND = true; // find() changes nothing
+
+  // Returns the stored record, or nullptr (record untouched) if the Batch ID
+  // already exists
+  Medicine *insert(uint64_t key, Medicine &med) {
+    string id = med.batchID;
+    auto result = records.try_emplace(std::move(id));
+    if (!result.second)
+      return nullptr;
+    result.first->second.key = key;
+    result.first->second.data = std::move(med);
+    return &result.first->second.data;
+  }
+
+  // Note: Before C++20 an unordered_map cannot be searched with a
+  // string_view, so the ID is copied (short IDs stay in the SSO buffer)
+  Medicine *find(uint64_t, string_view batchID) {
+    auto it = records.find(string(batchID));
+    return (it != records.end()) ? &it->second.data : nullptr;
+  }
+
+  bool remove(uint64_t, string_view batchID) {
+    return records.erase(string(batchID)) > 0;
+  }
+
+  // Calls visit(Medicine &) in Batch ID order
+  // A hash table has no order, so the entries are sorted first: O(n log n)
+  template <class Visit> void forEach(Visit visit) {
+    vector<Entry *> sorted;
+    sorted.reserve(records.size());
+    for (auto &entry : records) {
+      sorted.push_back(&entry.second);
+    }
+    sort(sorted.begin(), sorted.end(), [](const Entry *a, const Entry *b) {
+      return compareKeys(a->key, a->data.batchID, b->key, b->data.batchID) < 0;
+    });
+    for (Entry *entry : sorted) {
+      visit(entry->data);
+    }
+  }
+
+  void clear() { records.clear(); }
+  bool empty() const { return records.empty(); }
+};
+
+#endif
@@ -0,0 +1,241 @@
+/*
+ * Name: Lau Su Hui (Abby)
+ * Matric No.: MEC245045
+ * Semester: 20252026-1
+ * Course: MECS1023 ADSA
+ * Group & Theme: Group 1-Pharmacy Inventory Control System
+ * Assignment Title: Medicine Management System (Buffered Stock Export)
+ */
+
+#ifndef STOCK_EXPORT_H
+#define STOCK_EXPORT_H
+
+#include <cerrno>   // For EINTR (a write cut short by a signal)
+#include <charconv> // For to_chars (quantities without iostream)
+#include <cstdio>   // For FILE, fwrite (where POSIX write is missing)
+#include <iostream> // For flushing cout before writing to stdout
+#include <string>
+#include <string_view>
+
+#include "medicine_common.h"
+#include "snapshot_file.h" // For HAVE_POSIX_FILES (open, write, close)
+
+// ==========================================
+// BUFFERED STOCK EXPORT (LISTINGS & FILES)
+// ==========================================
+
+enum ExportFormat {
+  EXPORT_TABLE,      // Fixed-width columns (the "Display All" view)
+  EXPORT_CSV,        // Same columns as importCsv reads back
+  EXPORT_JSON_LINES, // One JSON object per batch per line
+};
+
+// Formats batches into one reusable buffer and writes it out in large
+// chunks (one write call per 64 KB) instead of one flushed line per batch
+// Logic: Every field is appended by hand (padding, to_chars, quoting),
+// so no iostream manipulator or per-row flush is on the hot path
+// The target is stdout (the default) or a file opened with open()
+class ExportWriter {
+private:
+  static const size_t CHUNK_SIZE = 1 << 16; // Bytes per write call
+
+  ExportFormat format;
+  string buffer;  // Formatted rows not yet written (reused)
+  bool toStdout;  // Target: stdout, or the file below
+  bool failed;    // A write failed (the rest is dropped)
+  size_t written; // Rows formatted so far
+#ifdef HAVE_POSIX_FILES
+  int fd; // Target file descriptor (-1 = none)
+#else
+  FILE *file; // Target file (nullptr = none)
+#endif
+
+  // Pads on the right like left << setw(width) (never cuts text off)
+  void appendPadded(string_view s, size_t width) {
+    buffer.append(s.data(), s.size());
+    if (s.size() < width)
+      buffer.append(width - s.size(), ' ');
+  }
+
+  void appendInt(long long value) {
+    char digits[24];
+    auto result = to_chars(digits, digits + sizeof(digits), value);
+    buffer.append(digits, result.ptr - digits);
+  }
+
+  // Quotes a field only if it holds a comma, quote or line break
+  void appendCsvField(string_view s) {
+    if (s.find_first_of(",\"\r\n") == string_view::npos) {
+      buffer.append(s.data(), s.size());
+      return;
+    }
+    buffer.push_back('"');
+    for (char c : s) {
+      if (c == '"')
+        buffer.push_back('"'); // "" stands for one quote
+      buffer.push_back(c);
+    }
+    buffer.push_back('"');
+  }
+
+  void appendJsonString(string_view s) {
+    static const char HEX[] = "0123456789abcdef";
+    buffer.push_back('"');
+    for (char c : s) {
+      if (c == '"' || c == '\\') {
+        buffer.push_back('\\');
+        buffer.push_back(c);
+      } else if (c == '\n') {
+        buffer.append("\\n");
+      } else if ((unsigned char)c < 0x20) {
+        buffer.append("\\u00");
+        buffer.push_back(HEX[(c >> 4) & 0xF]);
+        buffer.push_back(HEX[c & 0xF]);
+      } else {
+        buffer.push_back(c);
+      }
+    }
+    buffer.push_back('"');
+  }
+
+  // Writes all of 'buffer' to the target
+  bool writeOut() {
+#ifdef HAVE_POSIX_FILES
+    int target = toStdout ? STDOUT_FILENO : fd;
+    const char *p = buffer.data();
+    size_t left = buffer.size();
+    while (left > 0) {
+      ssize_t n = ::write(target, p, left);
+      if (n < 0 && errno == EINTR)
+        continue; // Interrupted by a signal: try again
+      if (n <= 0)
+        return false;
+      p += n;
+      left -= (size_t)n;
+    }
+    return true;
+#else
+    FILE *target = toStdout ? stdout : file;
+    return fwrite(buffer.data(), 1, buffer.size(), target) == buffer.size();
+#endif
+  }
+
+public:
+  // Constructor: writes to stdout until open() picks a file
+  explicit ExportWriter(ExportFormat exportFormat)
+      : format(exportFormat), toStdout(true), failed(false), written(0) {
+#ifdef HAVE_POSIX_FILES
+    fd = -1;
+#else
+    file = nullptr;
+#endif
+    buffer.reserve(CHUNK_SIZE + 1024);
+  }
+
+  ExportWriter(const ExportWriter &) = delete;
+  ExportWriter &operator=(const ExportWriter &) = delete;
+  ~ExportWriter() { close(); }
+
+  // Sends the output to a file instead (created or emptied)
+  // Returns false if the file cannot be created
+  bool open(const string &path) {
+    close();
+#ifdef HAVE_POSIX_FILES
+    fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    toStdout = fd < 0;
+    return fd >= 0;
+#else
+    file = fopen(path.c_str(), "wb");
+    toStdout = file == nullptr;
+    return file != nullptr;
+#endif
+  }
+
+  // Column titles (table: plus a rule; JSON lines have none)
+  void header() {
+    if (format == EXPORT_TABLE) {
+      appendPadded("Batch ID", 15);
+      appendPadded("Name", 25);
+      appendPadded("Quantity", 10);
+      appendPadded("Expiry", 15);
+      appendPadded("Location", 20);
+      buffer.push_back('\n');
+      buffer.append(85, '-');
+      buffer.push_back('\n');
+    } else if (format == EXPORT_CSV) {
+      buffer.append("Batch ID,Medicine Name,Quantity,Expiry Date,Location\n");
+    }
+  }
+
+  // Formats one batch (written once a whole chunk has built up)
+  void row(const Medicine &med) {
+    if (format == EXPORT_TABLE) {
+      appendPadded(med.batchID, 15);
+      appendPadded(med.medicineName, 25);
+      char digits[12];
+      auto result = to_chars(digits, digits + sizeof(digits), med.quantity);
+      appendPadded(string_view(digits, result.ptr - digits), 10);
+      appendPadded(med.expiryDate, 15);
+      appendPadded(med.location, 15);
+    } else if (format == EXPORT_CSV) {
+      appendCsvField(med.batchID);
+      buffer.push_back(',');
+      appendCsvField(med.medicineName);
+      buffer.push_back(',');
+      appendInt(med.quantity);
+      buffer.push_back(',');
+      appendCsvField(med.expiryDate);
+      buffer.push_back(',');
+      appendCsvField(med.location);
+    } else {
+      buffer.append("{\"batchID\":");
+      appendJsonString(med.batchID);
+      buffer.append(",\"medicineName\":");
+      appendJsonString(med.medicineName);
+      buffer.append(",\"quantity\":");
+      appendInt(med.quantity);
+      buffer.append(",\"expiryDate\":");
+      appendJsonString(med.expiryDate);
+      buffer.append(",\"location\":");
+      appendJsonString(med.location);
+      buffer.push_back('}');
+    }
+    buffer.push_back('\n');
+    written++;
+    if (buffer.size() >= CHUNK_SIZE)
+      flush();
+  }
+
+  // Writes out whatever is buffered; false once any write has failed
+  bool flush() {
+    if (!buffer.empty() && !failed) {
+      if (toStdout) {
+        cout.flush(); // Keep earlier console text in front of the rows
+        fflush(stdout);
+      }
+      failed = !writeOut();
+    }
+    buffer.clear();
+    return !failed;
+  }
+
+  // Flushes and closes the file (if any); false if anything was lost
+  bool close() {
+    bool ok = flush();
+#ifdef HAVE_POSIX_FILES
+    if (fd >= 0)
+      ok = (::close(fd) == 0) && ok;
+    fd = -1;
+#else
+    if (file != nullptr)
+      ok = (fclose(file) == 0) && ok;
+    file = nullptr;
+#endif
+    toStdout = true;
+    return ok;
+  }
+
+  size_t rows() const { return written; }
+};
+
+#endif
@@ -0,0 +1,242 @@
+/*
+ * Name: Lau Su Hui (Abby)
+ * Matric No.: MEC245045
+ * Semester: 20252026-1
+ * Course: MECS1023 ADSA
+ * Group & Theme: Group 1-Pharmacy Inventory Control System
+ * Assignment Title: Medicine Management System (Work-Stealing Task Pool)
+ */
+
+#ifndef TASK_POOL_H
+#define TASK_POOL_H
+
+#include <algorithm> // For stable_sort, merge (parallel sort)
+#include <atomic>
+#include <condition_variable> // For parking idle workers
+#include <deque>
+#include <functional> // For function (queued tasks)
+#include <memory>     // For unique_ptr (queues cannot move)
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// ==========================================
+// WORK-STEALING TASK POOL (FORK-JOIN)
+// ==========================================
+
+// A fixed set of threads that share fork-join work (e.g., the two halves
+// of a tree build)
+// Logic: Every thread has its own task queue. New tasks go to the back of
+// the submitting thread's queue and it takes them back from there (the
+// most recent, smallest task first, still warm in its cache); an idle
+// thread steals from the front of another queue (the oldest, biggest
+// task), so the work spreads out after only a few steals. Workers with
+// nothing to do or steal sleep on a condition variable until the next
+// submit(), so an idle pool costs no CPU time
+class TaskPool {
+private:
+  struct Queue {
+    mutex lock;
+    deque<function<void()>> tasks;
+  };
+
+  // Which pool's worker the calling thread is, and its queue there
+  struct ThreadSlot {
+    const TaskPool *pool;
+    int queue;
+  };
+
+  vector<unique_ptr<Queue>> queues; // queues[0] belongs to the owner thread
+  vector<thread> workers;           // Threads 1 ... threads - 1
+  atomic<bool> stopping;
+  atomic<size_t> queued;   // Tasks in all queues together
+  atomic<int> sleepers;    // Workers parked on 'idle' (or about to be)
+  mutex idleLock;          // Pairs with 'idle'
+  condition_variable idle; // Wakes a parked worker (submit, shutdown)
+
+  static ThreadSlot &threadSlot() {
+    static thread_local ThreadSlot slot = {nullptr, 0};
+    return slot;
+  }
+
+  // Queue of the calling thread: its own for this pool's workers, 0 for
+  // the owner and any other thread (including another pool's workers)
+  int currentQueue() const {
+    const ThreadSlot &slot = threadSlot();
+    return (slot.pool == this) ? slot.queue : 0;
+  }
+
+  // Takes a task: own queue first (newest), then steal (oldest)
+  bool take(function<void()> &task) {
+    int self = currentQueue();
+    {
+      Queue &own = *queues[self];
+      lock_guard<mutex> guard(own.lock);
+      if (!own.tasks.empty()) {
+        task = std::move(own.tasks.back());
+        own.tasks.pop_back();
+        queued--;
+        return true;
+      }
+    }
+    for (size_t k = 1; k < queues.size(); k++) {
+      Queue &victim = *queues[(self + k) % queues.size()];
+      lock_guard<mutex> guard(victim.lock);
+      if (!victim.tasks.empty()) {
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        queued--;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Worker loop: run or steal tasks; park while there are none
+  // Logic: A worker counts itself in 'sleepers' before it checks 'queued'
+  // and submit() adds to 'queued' before it checks 'sleepers', so at least
+  // one of them sees the other and no wake-up is lost
+  void work(int index) {
+    threadSlot() = {this, index};
+    while (!stopping) {
+      if (runOne())
+        continue;
+      unique_lock<mutex> guard(idleLock);
+      sleepers++;
+      idle.wait(guard, [this]() { return stopping || queued > 0; });
+      sleepers--;
+    }
+  }
+
+public:
+  // Constructor: 'threads' threads in total, counting the calling thread
+  explicit TaskPool(int threads) : stopping(false), queued(0), sleepers(0) {
+    if (threads < 1)
+      threads = 1;
+    for (int i = 0; i < threads; i++) {
+      queues.push_back(make_unique<Queue>());
+    }
+    for (int i = 1; i < threads; i++) {
+      workers.emplace_back([this, i]() { work(i); });
+    }
+  }
+
+  TaskPool(const TaskPool &) = delete;
+  TaskPool &operator=(const TaskPool &) = delete;
+
+  // Note: Every TaskGroup must have finished waiting before this
+  ~TaskPool() {
+    {
+      lock_guard<mutex> guard(idleLock);
+      stopping = true;
+    }
+    idle.notify_all();
+    for (auto &worker : workers) {
+      worker.join();
+    }
+  }
+
+  int threadCount() const { return (int)queues.size(); }
+
+  // Queues a task on the calling thread's own queue, waking a parked
+  // worker if there is one
+  void submit(function<void()> task) {
+    {
+      Queue &own = *queues[currentQueue()];
+      lock_guard<mutex> guard(own.lock);
+      own.tasks.push_back(std::move(task));
+      queued++;
+    }
+    if (sleepers > 0) {
+      lock_guard<mutex> guard(idleLock); // The sleeper is inside wait()
+      idle.notify_one();
+    }
+  }
+
+  // Runs one queued task, if there is any; returns false otherwise
+  bool runOne() {
+    function<void()> task;
+    if (!take(task))
+      return false;
+    task();
+    return true;
+  }
+};
+
+// Fork-join helper: run() forks tasks, wait() joins all of them
+// While waiting, the thread runs queued tasks itself (its own forks first),
+// so waiting never blocks a pool thread and nested groups cannot deadlock
+class TaskGroup {
+private:
+  TaskPool &pool;
+  atomic<int> pending;
+
+public:
+  explicit TaskGroup(TaskPool &owner) : pool(owner), pending(0) {}
+  TaskGroup(const TaskGroup &) = delete;
+  TaskGroup &operator=(const TaskGroup &) = delete;
+  ~TaskGroup() { wait(); }
+
+  template <class Task> void run(Task task) {
+    pending.fetch_add(1, memory_order_relaxed);
+    pool.submit([this, task]() {
+      task();
+      pending.fetch_sub(1, memory_order_release);
+    });
+  }
+
+  void wait() {
+    while (pending.load(memory_order_acquire) > 0) {
+      if (!pool.runOne())
+        this_thread::yield();
+    }
+  }
+};
+
+// ==========================================
+// PARALLEL ALGORITHMS
+// ==========================================
+
+// Below this many elements a task does its work alone (forking smaller
+// pieces costs more than it saves)
+const size_t PARALLEL_CUTOFF = 1 << 14;
+
+// Stable merge sort of [first, last) on the pool
+// Logic: The two halves are sorted in parallel (recursively), then merged
+// through 'buffer', which must have room for last - first elements
+template <class T, class Less>
+void parallelStableSort(T *first, T *last, T *buffer, Less less,
+                        TaskPool &pool) {
+  size_t n = last - first;
+  if (n <= PARALLEL_CUTOFF || pool.threadCount() == 1) {
+    stable_sort(first, last, less);
+    return;
+  }
+  T *mid = first + n / 2;
+  {
+    TaskGroup group(pool);
+    group.run([=, &pool]() {
+      parallelStableSort(first, mid, buffer, less, pool);
+    });
+    parallelStableSort(mid, last, buffer + n / 2, less, pool);
+  } // Joins the left half
+  merge(first, mid, mid, last, buffer, less);
+  copy(buffer, buffer + n, first);
+}
+
+// Calls body(i) for every i in [0, n), in chunks spread over the pool
+template <class Body> void parallelFor(size_t n, Body body, TaskPool &pool) {
+  TaskGroup group(pool);
+  for (size_t lo = 0; lo < n; lo += PARALLEL_CUTOFF) {
+    size_t hi = (n - lo > PARALLEL_CUTOFF) ? lo + PARALLEL_CUTOFF : n;
+    group.run([lo, hi, &body]() {
+      for (size_t i = lo; i < hi; i++) {
+        body(i);
+      }
+    });
+  }
+}
+
+#endif
@@ -0,0 +1,168 @@
+/*
+ * Name: Lau Su Hui (Abby)
+ * Matric No.: MEC245045
+ * Semester: 20252026-1
+ * Course: MECS1023 ADSA
+ * Group & Theme: Group 1-Pharmacy Inventory Control System
+ * Assignment Title: Medicine Management System (Treap Engine)
+ */
+
+#ifndef TREAP_ENGINE_H
+#define TREAP_ENGINE_H
+
+#include "tree_nodes.h"
+
+// This structure represents a "Node" in the Treap
+struct TreapNode {
+  uint64_t key;      // Encoded Batch ID (or STRING_KEY), compared first
+  Medicine data;     // The medicine details
+  TreapNode *left;   // Pointer to left child (smaller Batch ID)
+  TreapNode *right;  // Pointer to right child (larger Batch ID)
+  uint32_t priority; // TREAP SPECIFIC: Random heap priority
+
+  // Constructor to initialise a detached node (priority set by the engine)
+  // The record is moved in, so its strings are never deep-copied
+  TreapNode(Medicine &&med, uint64_t code) : data(std::move(med)) {
+    init(code);
+  }
+
+  void init(uint64_t code) {
+    key = code;
+    left = nullptr;
+    right = nullptr;
+    priority = 0;
+  }
+};
+
+// ==========================================
+// TREAP ENGINE (PLUGS INTO MedicineManager)
+// ==========================================
+
+// A BST by Batch ID that is also a max-heap by a random priority per node.
+// The random priorities make the shape that of a BST built from a random
+// insertion order, so the expected height is O(log n) whatever order the
+// batches really arrive in (sorted receiving dock order included).
+class TreapEngine : public LinkedTreeEngine<TreapEngine, TreapNode> {
+private:
+  uint32_t rngState;         // xorshift32 state for the priorities
+  vector<TreapNode **> path; // Insert path (kept to reuse its memory)
+
+  // Three-way comparison of a (key, Batch ID) pair against a node
+  static int compareKey(uint64_t key, string_view batchID,
+                        const TreapNode *node) {
+    return compareKeys(key, batchID, node->key, node->data.batchID);
+  }
+
+  // Helper: Next random priority (xorshift32, independent of rand())
+  uint32_t nextPriority() {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+  }
+
+public:
+  static constexpr const char *NAME = "Treap";
+  static constexpr const char *RESULTS_FILE = "treap_results.txt";
+  static constexpr bool STABLE_RECORDS = true; // Nodes never move
+  static constexpr bool READ_ONLY_FIND = true; // find() changes nothing
+
+  TreapEngine() { rngState = 2463534242u; }
+
+  // --- CORE OPERATIONS: INSERT, SEARCH, DELETE ---
+
+  // Iterative insert; the record is only moved into the new node
+  // Logic: Insert as a BST leaf, then rotate it up while its priority is
+  // higher than its parent's. 'path' holds the links leading down to it
+  // Returns the stored record, or nullptr (record untouched) if the Batch ID
+  // already exists
+  Medicine *insert(uint64_t key, Medicine &med) {
+    path.clear();
+    TreapNode **link = &root;
+    while (*link != nullptr) {
+      int cmp = compareKey(key, med.batchID, *link);
+      if (cmp == 0)
+        return nullptr; // Duplicate Case: Batch ID already exists
+      path.push_back(link);
+      link = (cmp < 0) ? &(*link)->left : &(*link)->right;
+    }
+    TreapNode *node = createNode(std::move(med), key);
+    node->priority = nextPriority();
+    *link = node;
+
+    // Restore the heap order: each rotation lifts the node one level
+    while (!path.empty()) {
+      TreapNode **parentLink = path.back();
+      TreapNode *parent = *parentLink;
+      if (parent->priority >= node->priority)
+        break;
+      if (parent->left == node) {
+        parent->left = node->right; // Right Rotation
+        node->right = parent;
+      } else {
+        parent->right = node->left; // Left Rotation
+        node->left = parent;
+      }
+      *parentLink = node;
+      path.pop_back();
+    }
+    return &node->data;
+  }
+
+  // Iterative search (a plain BST descent)
+  Medicine *find(uint64_t key, string_view batchID) {
+    TreapNode *current = root;
+    while (current != nullptr) {
+      int cmp = compareKey(key, batchID, current);
+      if (cmp == 0)
+        return &current->data;
+      current = (cmp < 0) ? current->left : current->right;
+    }
+    return nullptr;
+  }
+
+  // Iterative delete
+  // Logic: Rotate the node down (the higher-priority child goes up) until
+  // it has at most one child, then splice it out
+  bool remove(uint64_t key, string_view batchID) {
+    TreapNode **link = &root;
+    while (*link != nullptr) {
+      int cmp = compareKey(key, batchID, *link);
+      if (cmp == 0)
+        break;
+      link = (cmp < 0) ? &(*link)->left : &(*link)->right;
+    }
+    TreapNode *target = *link;
+    if (target == nullptr)
+      return false;
+
+    while (target->left != nullptr && target->right != nullptr) {
+      TreapNode *child;
+      if (target->left->priority > target->right->priority) {
+        child = target->left; // Right Rotation
+        target->left = child->right;
+        child->right = target;
+        *link = child;
+        link = &child->right;
+      } else {
+        child = target->right; // Left Rotation
+        target->right = child->left;
+        child->left = target;
+        *link = child;
+        link = &child->left;
+      }
+    }
+    *link = (target->left != nullptr) ? target->left : target->right;
+    destroyNode(target);
+    return true;
+  }
+
+  // forEach, clear, empty, reduce, setPoolEnabled and the ordered
+  // iterators come from LinkedTreeEngine (tree_nodes.h)
+
+  // --- OPTIONAL EXTRAS ---
+  // Number of levels from the root down to the deepest leaf
+  int height() { return subtreeHeight(root); }
+};
+
+#endif
@@ -0,0 +1,595 @@
+/*
+ * Name: Lau Su Hui (Abby)
+ * Matric No.: MEC245045
+ * Semester: 20252026-1
+ * Course: MECS1023 ADSA
+ * Group & Theme: Group 1-Pharmacy Inventory Control System
+ * Assignment Title: Medicine Management System (Binary Tree Building Blocks)
+ */
+
+#ifndef TREE_NODES_H
+#define TREE_NODES_H
+
+#include <new>     // For placement new (node pool)
+#include <utility> // For move (zero-copy insertion)
+#include <vector>
+
+#include "medicine_common.h"
+#include "task_pool.h"
+
+// Shared parts of the pointer-based engines (BST, AVL, red-black, treap,
+// splay). Every node type NodeT used with them provides:
+//   uint64_t key; Medicine data; NodeT *left; NodeT *right;
+//   NodeT(Medicine &&med, uint64_t key)  builds a detached node
+//   void init(uint64_t key)              resets key and links for reuse
+
+// ==========================================
+// 1. NODE MEMORY
+// ==========================================
+
+// Slab allocator that owns the memory of every node in the tree
+// Logic: Nodes are carved out of large blocks ("slabs") instead of one
+// 'new' per batch, deleted nodes go onto a free list for reuse, and the
+// whole tree can be released in O(1) by rewinding the slab cursor.
+// Released nodes keep their constructed Medicine so the strings' buffers
+// are reused on the next insert; destructors only run when the pool dies.
+template <class NodeT> class NodePool {
+private:
+  static const size_t SLAB_NODES = 4096; // Nodes per slab
+
+  vector<NodeT *> slabs; // Raw memory blocks, SLAB_NODES nodes each
+  size_t constructed;    // Slots that already hold a constructed node
+  size_t next;           // Bump cursor: next never-used slot since reset
+  NodeT *freeList;       // Recycled nodes, chained through their 'left'
+
+  NodeT *slot(size_t i) { return slabs[i / SLAB_NODES] + (i % SLAB_NODES); }
+
+public:
+  NodePool() : constructed(0), next(0), freeList(nullptr) {}
+  NodePool(const NodePool &) = delete;
+  NodePool &operator=(const NodePool &) = delete;
+
+  ~NodePool() {
+    for (size_t i = 0; i < constructed; i++) {
+      slot(i)->~NodeT();
+    }
+    for (NodeT *slab : slabs) {
+      ::operator delete(slab);
+    }
+  }
+
+  // Hands out a detached node holding 'med'
+  NodeT *create(Medicine &&med, uint64_t key) {
+    NodeT *n;
+    if (freeList != nullptr) {
+      // 1. Reuse a node freed by a deletion
+      n = freeList;
+      freeList = n->left;
+    } else if (next < constructed) {
+      // 2. Reuse a slot released by reset()
+      n = slot(next++);
+    } else {
+      // 3. Construct a fresh node, adding a slab when the last one is full
+      if (next == slabs.size() * SLAB_NODES) {
+        slabs.push_back(
+            static_cast<NodeT *>(::operator new(SLAB_NODES * sizeof(NodeT))));
+      }
+      n = new (slot(next++)) NodeT(std::move(med), key);
+      constructed++;
+      return n;
+    }
+    n->data = std::move(med);
+    n->init(key);
+    return n;
+  }
+
+  // Returns a single node to the free list
+  void destroy(NodeT *n) {
+    n->left = freeList;
+    freeList = n;
+  }
+
+  // Releases every node at once: O(1), no per-node work
+  void reset() {
+    next = 0;
+    freeList = nullptr;
+  }
+};
+
+// Frees every node of a subtree one by one (heap mode)
+// Iterative: each node's children are pushed before it is deleted
+template <class NodeT> void deleteNodes(NodeT *node) {
+  vector<NodeT *> stack;
+  if (node != nullptr)
+    stack.push_back(node);
+  while (!stack.empty()) {
+    NodeT *current = stack.back();
+    stack.pop_back();
+    if (current->left != nullptr)
+      stack.push_back(current->left);
+    if (current->right != nullptr)
+      stack.push_back(current->right);
+    delete current;
+  }
+}
+
+// Node allocation switch: NodePool or plain new/delete
+// All node creation/destruction of an engine goes through one of these
+template <class NodeT> class NodeAllocator {
+private:
+  NodePool<NodeT> pool; // Slab allocator that owns the nodes (when enabled)
+  bool usePool;         // Switch: true = NodePool, false = plain new/delete
+
+public:
+  NodeAllocator() : usePool(true) {}
+
+  NodeT *create(Medicine &&med, uint64_t key) {
+    if (usePool) {
+      return pool.create(std::move(med), key);
+    }
+    return new NodeT(std::move(med), key);
+  }
+
+  void destroy(NodeT *node) {
+    if (usePool) {
+      pool.destroy(node);
+    } else {
+      delete node;
+    }
+  }
+
+  // Releases a whole tree: O(1) in pool mode, node by node on the heap
+  void releaseAll(NodeT *root) {
+    if (usePool) {
+      pool.reset();
+    } else {
+      deleteNodes(root);
+    }
+  }
+
+  // Note: Only call this with no live nodes, since nodes cannot change owner
+  void setPoolEnabled(bool enabled) { usePool = enabled; }
+};
+
+// ==========================================
+// 2. ORDERED TRAVERSAL
+// ==========================================
+
+// Collects the nodes of a subtree in Batch ID order (explicit stack, so
+// even a list-shaped tree cannot overflow the call stack)
+template <class NodeT> void collectNodes(NodeT *current, vector<NodeT *> &out) {
+  vector<NodeT *> stack;
+  while (current != nullptr || !stack.empty()) {
+    while (current != nullptr) {
+      stack.push_back(current);
+      current = current->left;
+    }
+    current = stack.back();
+    stack.pop_back();
+    out.push_back(current);
+    current = current->right;
+  }
+}
+
+// Number of levels of a subtree (0 = empty), via an explicit stack of
+// (node, depth) pairs so a list-shaped tree is fine too
+template <class NodeT> int subtreeHeight(NodeT *root) {
+  int height = 0;
+  vector<pair<NodeT *, int>> stack;
+  if (root != nullptr)
+    stack.push_back({root, 1});
+  while (!stack.empty()) {
+    NodeT *current = stack.back().first;
+    int depth = stack.back().second;
+    stack.pop_back();
+    if (depth > height)
+      height = depth;
+    if (current->left != nullptr)
+      stack.push_back({current->left, depth + 1});
+    if (current->right != nullptr)
+      stack.push_back({current->right, depth + 1});
+  }
+  return height;
+}
+
+// Folds every record of a subtree into one Partial (a stock report)
+//   add(Partial &, const Medicine &)     counts one batch in
+//   merge(Partial &into, Partial &&from) combines two partial results
+// Logic: The top 'forkDepth' levels fork their left subtree onto the pool
+// and fold the right one themselves, each into its own Partial, and merge
+// the two on the way back up; below that (or without a pool) an iterative
+// walk does the work. Batches are not visited in Batch ID order
+template <class Partial, class NodeT, class Add, class Merge>
+Partial reduceSubtree(NodeT *root, const Add &add, const Merge &merge,
+                      TaskPool *pool, int forkDepth) {
+  Partial result{};
+  if (pool == nullptr || forkDepth <= 0 || root == nullptr) {
+    vector<NodeT *> stack;
+    if (root != nullptr)
+      stack.push_back(root);
+    while (!stack.empty()) {
+      NodeT *current = stack.back();
+      stack.pop_back();
+      add(result, current->data);
+      if (current->left != nullptr)
+        stack.push_back(current->left);
+      if (current->right != nullptr)
+        stack.push_back(current->right);
+    }
+    return result;
+  }
+
+  Partial leftPart{};
+  {
+    TaskGroup group(*pool);
+    group.run([&]() {
+      leftPart = reduceSubtree<Partial>(root->left, add, merge, pool,
+                                        forkDepth - 1);
+    });
+    result =
+        reduceSubtree<Partial>(root->right, add, merge, pool, forkDepth - 1);
+  } // Joins the left subtree
+  add(result, root->data);
+  merge(result, std::move(leftPart));
+  return result;
+}
+
+// Bulk load, step 1: merges (key, record) pairs sorted by Batch ID with the
+// nodes of a subtree into one node list in Batch ID order
+//   compare(key, batchID, const NodeT *)  three-way, like compareKeys
+//   create(Medicine &&, key)              a new detached node
+// Duplicates are skipped (first one wins); added records are moved from,
+// and 'added' counts them
+template <class NodeT, class Compare, class Create>
+vector<NodeT *> mergeSortedNodes(NodeT *root,
+                                 vector<pair<uint64_t, Medicine *>> &incoming,
+                                 const Compare &compare, const Create &create,
+                                 size_t &added) {
+  // 1. Flatten the current tree, which is already in order
+  vector<NodeT *> existing;
+  collectNodes(root, existing);
+
+  // 2. Merge both sorted lists, skipping duplicates
+  vector<NodeT *> merged;
+  merged.reserve(existing.size() + incoming.size());
+  size_t i = 0;
+  added = 0;
+  for (auto &entry : incoming) {
+    uint64_t key = entry.first;
+    Medicine &med = *entry.second;
+    while (i < existing.size() && compare(key, med.batchID, existing[i]) > 0) {
+      merged.push_back(existing[i++]);
+    }
+    // Already stored, or repeated within the input
+    if ((i < existing.size() && compare(key, med.batchID, existing[i]) == 0) ||
+        (!merged.empty() && compare(key, med.batchID, merged.back()) == 0))
+      continue;
+    merged.push_back(create(std::move(med), key));
+    added++;
+  }
+  while (i < existing.size()) {
+    merged.push_back(existing[i++]);
+  }
+  return merged;
+}
+
+// Bulk load, step 2: relinks sorted nodes [lo, hi) into a perfectly
+// balanced subtree and returns its root
+// Logic: The middle node becomes the root, each half becomes a child
+// (recursion depth is only log2(n), since the result is balanced), and
+// fix(NodeT *) runs on each node once both of its children are linked
+// (e.g. the AVL height). With a pool, the two halves of ranges above
+// PARALLEL_CUTOFF are built at the same time (same shape either way)
+template <class NodeT, class Fix>
+NodeT *linkBalanced(vector<NodeT *> &sorted, size_t lo, size_t hi,
+                    const Fix &fix, TaskPool *pool) {
+  if (lo >= hi)
+    return nullptr;
+  size_t mid = lo + (hi - lo) / 2;
+  NodeT *node = sorted[mid];
+  if (pool != nullptr && hi - lo > PARALLEL_CUTOFF) {
+    TaskGroup group(*pool);
+    group.run([&]() { node->left = linkBalanced(sorted, lo, mid, fix, pool); });
+    node->right = linkBalanced(sorted, mid + 1, hi, fix, pool);
+  } else {
+    node->left = linkBalanced(sorted, lo, mid, fix, pool);
+    node->right = linkBalanced(sorted, mid + 1, hi, fix, pool);
+  }
+  fix(node); // Both halves are done (and joined), so the node is final
+  return node;
+}
+
+// Forward iterator over the batches in Batch ID order (no printing)
+// The stack holds the current node on top and, below it, the ancestors
+// still waiting to be visited, so no recursion is needed and advancing
+// costs O(1) amortised
+// Note: Any add/remove invalidates existing iterators
+template <class NodeT> class TreeIterator {
+public:
+  // Iterator at the first node of the subtree (nullptr = end)
+  static TreeIterator first(NodeT *root) {
+    TreeIterator it;
+    it.pushLeftSpine(root);
+    return it;
+  }
+
+  // Iterator at the first node >= (key, batchID), or at the first node
+  // > (key, batchID) when 'strict' is set
+  // Every node where the descent turns left is still ahead of the result,
+  // so it is pushed as a pending ancestor
+  static TreeIterator bound(NodeT *root, uint64_t key, string_view batchID,
+                            bool strict) {
+    TreeIterator it;
+    NodeT *current = root;
+    while (current != nullptr) {
+      int cmp = compareKeys(key, batchID, current->key, current->data.batchID);
+      if (cmp < 0 || (cmp == 0 && !strict)) {
+        it.stack.push_back(current);
+        current = current->left;
+      } else {
+        current = current->right;
+      }
+    }
+    return it;
+  }
+
+  Medicine &operator*() const { return stack.back()->data; }
+  Medicine *operator->() const { return &stack.back()->data; }
+
+  // Encoded key of the current batch
+  uint64_t key() const { return stack.back()->key; }
+
+  // Move to the next batch: leftmost node of the right subtree, or the
+  // nearest ancestor still on the stack
+  TreeIterator &operator++() {
+    NodeT *current = stack.back()->right;
+    stack.pop_back();
+    pushLeftSpine(current);
+    return *this;
+  }
+
+  bool operator==(const TreeIterator &other) const {
+    return node() == other.node();
+  }
+  bool operator!=(const TreeIterator &other) const { return !(*this == other); }
+
+private:
+  vector<NodeT *> stack;
+
+  NodeT *node() const { return stack.empty() ? nullptr : stack.back(); }
+
+  void pushLeftSpine(NodeT *current) {
+    while (current != nullptr) {
+      stack.push_back(current);
+      current = current->left;
+    }
+  }
+};
+
+// ==========================================
+// 3. FROZEN SNAPSHOT (READ-OPTIMISED LAYOUT)
+// ==========================================
+
+// The packed keys of a tree in Eytzinger (BFS) order, i.e. slot 1 is the
+// root of an implicit balanced tree and slot k has children 2k and 2k + 1,
+// so lookups walk one contiguous array instead of scattered nodes
+// The owning engine must clear() it whenever a node is added or deleted
+template <class NodeT> class FrozenIndex {
+private:
+  vector<uint64_t> keys; // Slot 0 unused; empty = not frozen
+  vector<NodeT *> nodes; // nodes[k] holds the record of slot k
+
+  // Fills slot k's subtree of the snapshot from the sorted nodes
+  // An in-order walk of the implicit tree takes them in Batch ID order;
+  // the recursion is only log2(n) deep
+  void fill(const vector<NodeT *> &sorted, size_t &next, size_t k) {
+    if (k >= keys.size())
+      return;
+    fill(sorted, next, 2 * k);
+    keys[k] = sorted[next]->key;
+    nodes[k] = sorted[next];
+    next++;
+    fill(sorted, next, 2 * k + 1);
+  }
+
+public:
+  // Exports the tree rooted at 'root' into the snapshot
+  void build(NodeT *root) {
+    vector<NodeT *> sorted;
+    collectNodes(root, sorted);
+    keys.assign(sorted.size() + 1, 0);
+    nodes.assign(sorted.size() + 1, nullptr);
+    size_t next = 0;
+    fill(sorted, next, 1);
+  }
+
+  // Drops the snapshot (lookups go back to the tree)
+  void clear() {
+    keys.clear();
+    nodes.clear();
+  }
+
+  // True while the snapshot matches the tree
+  bool active() const { return !keys.empty(); }
+
+  // Branchless search of the snapshot (packed keys only)
+  // Logic: Every step goes to slot 2k or 2k + 1 depending on one compare,
+  // which compiles to arithmetic instead of a jump, so there are no branch
+  // mispredictions. Slots 8k ... 8k + 7 (three levels further down) are 64
+  // bytes apart from each other at most, so prefetching them early hides
+  // most of the memory latency of the deeper levels. Near the leaves 8k is
+  // past the array, so the prefetch slot is clamped to the last key (a
+  // conditional move, not a branch) instead of forming a pointer past it
+  NodeT *find(uint64_t key) const {
+    const uint64_t *data = keys.data();
+    size_t n = keys.size() - 1;
+    size_t k = 1;
+    while (k <= n) {
+      size_t ahead = 8 * k;
+      __builtin_prefetch(data + (ahead <= n ? ahead : n));
+      k = 2 * k + (data[k] < key);
+    }
+    // Undo the trailing right turns: k becomes the first key >= the target
+    k >>= __builtin_ffsll(~(long long)k);
+    if (k != 0 && data[k] == key)
+      return nodes[k];
+    return nullptr;
+  }
+};
+
+// ==========================================
+// 4. TREE SHAPE & WORK COUNTERS
+// ==========================================
+
+// How deep the nodes of a tree sit (root = depth 0, so the deepest node
+// is at depth height - 1)
+struct TreeStats {
+  size_t nodes;               // Nodes in the tree
+  int height;                 // Levels (0 = empty)
+  double averageDepth;        // Mean depth over all nodes (0 if empty)
+  vector<size_t> depthCounts; // depthCounts[d] = nodes at depth d
+};
+
+// Measures a subtree with an explicit stack of (node, depth) pairs, like
+// subtreeHeight, so a list-shaped tree is fine too
+template <class NodeT> TreeStats collectTreeStats(NodeT *root) {
+  TreeStats stats = {0, 0, 0, {}};
+  long double depthSum = 0;
+  vector<pair<NodeT *, size_t>> stack;
+  if (root != nullptr)
+    stack.push_back({root, 0});
+  while (!stack.empty()) {
+    NodeT *current = stack.back().first;
+    size_t depth = stack.back().second;
+    stack.pop_back();
+    if (depth >= stats.depthCounts.size())
+      stats.depthCounts.resize(depth + 1, 0);
+    stats.depthCounts[depth]++;
+    stats.nodes++;
+    depthSum += depth;
+    if (current->left != nullptr)
+      stack.push_back({current->left, depth + 1});
+    if (current->right != nullptr)
+      stack.push_back({current->right, depth + 1});
+  }
+  stats.height = (int)stats.depthCounts.size();
+  if (stats.nodes > 0)
+    stats.averageDepth = (double)(depthSum / stats.nodes);
+  return stats;
+}
+
+// Rebalancing cases, named after the path to the too-deep grandchild
+// (LL and RR take one rotation, LR and RL two)
+enum RotationCase { ROTATE_LL, ROTATE_RR, ROTATE_LR, ROTATE_RL };
+
+// What an engine's inserts, searches and deletes did, beyond wall time
+struct WorkCounts {
+  uint64_t comparisons;  // Key comparisons (compareKey calls)
+  uint64_t nodesVisited; // Nodes stepped on while descending or walking
+  uint64_t rotations[4]; // Rebalancing cases, indexed by RotationCase
+};
+
+// Work counters of an engine, switched at compile time
+// Logic: With ENABLED = false every call is an empty inline function and
+// nothing is stored, so the normal engines carry no counting code at all;
+// the counting variants (e.g. CountingAVLEngine) set it to true
+template <bool ENABLED> class WorkCounter {
+private:
+  WorkCounts counts;
+
+public:
+  WorkCounter() { reset(); }
+  void reset() { counts = WorkCounts(); }
+  void compared() { counts.comparisons++; }
+  void visited() { counts.nodesVisited++; }
+  void rotated(RotationCase kind) { counts.rotations[kind]++; }
+  WorkCounts get() const { return counts; }
+};
+
+template <> class WorkCounter<false> {
+public:
+  void reset() {}
+  void compared() {}
+  void visited() {}
+  void rotated(RotationCase) {}
+  WorkCounts get() const { return WorkCounts(); }
+};
+
+// ==========================================
+// 5. SHARED ENGINE MEMBERS
+// ==========================================
+
+// The root, the node allocator and every member that only walks or
+// empties the tree, written once for the pointer-based engines
+// Logic: An engine derives from LinkedTreeEngine<itself, its node type>,
+// so the shared members reach its hook without a virtual call:
+//   void nodesChanged()   runs before a node is created or released (the
+//                         BST and AVL drop their frozen snapshot there)
+// Insert, find, remove and the per-node fix-ups stay in the engine
+template <class Engine, class NodeT> class LinkedTreeEngine {
+protected:
+  NodeT *root;                // The root pointer of the tree
+  NodeAllocator<NodeT> nodes; // Node pool or plain new/delete
+
+  LinkedTreeEngine() : root(nullptr) {}
+  ~LinkedTreeEngine() { nodes.releaseAll(root); }
+
+  // Default hook: nothing else depends on which nodes exist
+  void nodesChanged() {}
+
+  // --- NODE ALLOCATION ---
+  NodeT *createNode(Medicine &&med, uint64_t key) {
+    static_cast<Engine *>(this)->nodesChanged();
+    return nodes.create(std::move(med), key);
+  }
+
+  void destroyNode(NodeT *node) {
+    static_cast<Engine *>(this)->nodesChanged();
+    nodes.destroy(node);
+  }
+
+public:
+  typedef TreeIterator<NodeT> Iterator;
+
+  LinkedTreeEngine(const LinkedTreeEngine &) = delete;
+  LinkedTreeEngine &operator=(const LinkedTreeEngine &) = delete;
+
+  // In-Order Traversal: calls visit(Medicine &) in Batch ID order
+  template <class Visit> void forEach(Visit visit) {
+    for (Iterator it = begin(); it != end(); ++it) {
+      visit(*it);
+    }
+  }
+
+  // Empties the whole tree
+  void clear() {
+    static_cast<Engine *>(this)->nodesChanged();
+    nodes.releaseAll(root);
+    root = nullptr;
+  }
+
+  bool empty() const { return root == nullptr; }
+
+  // Folds every batch into one Partial, forking the top 'forkDepth'
+  // levels onto the pool (see reduceSubtree above)
+  template <class Partial, class Add, class Merge>
+  Partial reduce(const Add &add, const Merge &merge, TaskPool *pool,
+                 int forkDepth) {
+    return reduceSubtree<Partial>(root, add, merge, pool, forkDepth);
+  }
+
+  // Switches between the node pool and plain new/delete (empties the tree)
+  void setPoolEnabled(bool enabled) {
+    clear();
+    nodes.setPoolEnabled(enabled);
+  }
+
+  // Ordered iteration
+  Iterator begin() { return Iterator::first(root); }
+  Iterator end() { return Iterator(); }
+  Iterator bound(uint64_t key, string_view batchID, bool strict) {
+    return Iterator::bound(root, key, batchID, strict);
+  }
+};
+
+#endif
@@ -0,0 +1,417 @@
+/*
+ * Name: Lau Su Hui (Abby)
+ * Matric No.: MEC245045
+ * Semester: 20252026-1
+ * Course: MECS1023 ADSA
+ * Group & Theme: Group 1-Pharmacy Inventory Control System
+ * Assignment Title: Medicine Management System (Write-Ahead Log)
+ */
+
+#ifndef WAL_FILE_H
+#define WAL_FILE_H
+
+#include <chrono>             // For the group commit timer
+#include <condition_variable> // For waking the flusher thread
+#include <cstdio>             // For FILE, fwrite, fflush (appending to the log)
+#include <cstring>            // For memcpy, memcmp (raw record bytes)
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread> // For the flusher thread (commit timer)
+
+#include "medicine_common.h"
+#include "snapshot_file.h" // For snapshotChecksum, MappedFile, syncFile
+
+// ==========================================
+// WRITE-AHEAD LOG (DURABLE ADDS & DELETES)
+// ==========================================
+
+// Layout: a 16-byte file header, then one record per successful change
+//   WalRecordHeader   payload length, operation, checksum of the payload
+//   payload           add:    quantity, then Batch ID, name, expiry date
+//                             and location, each as (uint32 length, bytes)
+//                     remove: the Batch ID as (uint32 length, bytes)
+//                     update: the new quantity, then the Batch ID
+// A crash can only ever tear the last record; replay stops at the first
+// record that is short or fails its checksum and drops everything after it
+const char WAL_MAGIC[8] = {'M', 'E', 'D', 'W', 'A', 'L', '\0', '\0'};
+const uint32_t WAL_VERSION = 2; // Bump on any layout change
+// Version 1 logs hold only adds and removes, which version 2 reads the
+// same way; replay rewrites their header, since updates may follow
+
+struct WalFileHeader {
+  char magic[8];     // WAL_MAGIC
+  uint32_t version;  // WAL_VERSION
+  uint32_t reserved; // Always 0
+};
+
+enum WalOperation : uint32_t { WAL_ADD = 1, WAL_REMOVE = 2, WAL_UPDATE = 3 };
+
+struct WalRecordHeader {
+  uint32_t length;    // Payload bytes after this header
+  uint32_t operation; // WAL_ADD, WAL_REMOVE or WAL_UPDATE
+  uint64_t checksum;  // snapshotChecksum of the payload, seeded with the op
+};
+
+static_assert(sizeof(WalFileHeader) == 16, "log header layout");
+static_assert(sizeof(WalRecordHeader) == 16, "log record layout");
+
+// Append-only log of adds and deletes with group commit
+// Logic: Records collect in a memory buffer and reach the disk together,
+// with one fsync for the whole group, once 'commitEvery' changes are
+// waiting or 'commitMs' milliseconds have passed since the last sync.
+// The timer is kept by a flusher thread (only started when commitMs > 0),
+// so the last group of a burst is synced on time even if no further change
+// arrives. commitEvery = 1 syncs every change before it returns; bigger
+// groups trade the last few unsynced changes (lost on a power cut, never
+// torn) for far fewer fsyncs.
+// A sync that fails (e.g., a full disk) loses nothing: unwritten records
+// stay pending, written ones stay marked unsynced, and the next sync tries
+// again. Until one succeeds, every log call returns false.
+class WriteAheadLog {
+private:
+  FILE *file;         // Open for appending (nullptr = closed)
+  string path;        // The log file
+  string pending;     // Records not yet written to the file
+  size_t pendingOps;  // Records in 'pending'
+  size_t commitEvery; // Group size (1 = sync every change)
+  int commitMs;       // Longest wait for a sync (0 = no timer)
+  size_t syncs;       // fsyncs since open() (for the experiment)
+  bool unsynced;      // Records handed to 'file' but not yet fsynced
+  bool syncFailed;    // The last sync hit an I/O error
+  chrono::steady_clock::time_point lastSync;
+
+  mutable mutex lock;      // Guards the members above (writer vs flusher)
+  condition_variable wake; // First record of a group, or close()
+  thread flusher;          // Syncs a group once commitMs has passed
+  bool stopping;           // Tells the flusher to finish
+
+  void putU32(uint32_t value) { pending.append((const char *)&value, 4); }
+
+  void putString(string_view s) {
+    putU32((uint32_t)s.size());
+    pending.append(s.data(), s.size());
+  }
+
+  // Frames the payload written after 'start' as one record, then syncs if
+  // the group is complete (and 'commit' is set)
+  void finishRecord(size_t start, WalOperation op, bool commit) {
+    WalRecordHeader header;
+    header.length = (uint32_t)(pending.size() - start - sizeof(header));
+    header.operation = op;
+    header.checksum = snapshotChecksum(pending.data() + start + sizeof(header),
+                                       header.length, op);
+    memcpy(&pending[start], &header, sizeof(header));
+    pendingOps++;
+    if (pendingOps == 1 && commitMs > 0)
+      wake.notify_one(); // The flusher starts timing this group
+    if (!commit)
+      return;
+    if (pendingOps >= commitEvery ||
+        (commitMs > 0 && chrono::steady_clock::now() - lastSync >=
+                             chrono::milliseconds(commitMs)))
+      syncLocked();
+  }
+
+  // Writes the waiting group and fsyncs it (caller holds 'lock')
+  // 1. Hand the records to the file; after a short write only the part
+  //    that did not make it stays pending, so no byte is written twice
+  // 2. Flush and fsync whatever was handed over, now or by a failed sync
+  bool syncLocked() {
+    if (file == nullptr)
+      return false;
+    if (!pending.empty()) {
+      size_t written = fwrite(pending.data(), 1, pending.size(), file);
+      pending.erase(0, written);
+      unsynced = unsynced || written > 0;
+    }
+    bool ok = pending.empty();
+    if (ok)
+      pendingOps = 0;
+    else
+      clearerr(file); // Let the retry write again
+    if (unsynced) {
+      bool durable = fflush(file) == 0;
+#ifdef HAVE_POSIX_FILES
+      durable = durable && fsync(fileno(file)) == 0;
+#endif
+      syncs++;
+      unsynced = !durable;
+      ok = ok && durable;
+    }
+    syncFailed = !ok;
+    lastSync = chrono::steady_clock::now(); // A failure is retried later
+    return ok;
+  }
+
+  // Flusher thread: sleeps until a group starts, then syncs it once
+  // 'commitMs' have passed since the last sync (unless the writer's own
+  // sync got there first)
+  void flushLoop() {
+    unique_lock<mutex> guard(lock);
+    while (!stopping) {
+      if (pendingOps == 0) {
+        wake.wait(guard);
+        continue;
+      }
+      auto due = lastSync + chrono::milliseconds(commitMs);
+      if (chrono::steady_clock::now() >= due) {
+        syncLocked();
+      } else {
+        wake.wait_until(guard, due);
+      }
+    }
+  }
+
+  // Opens the log for appending, unbuffered: 'pending' already collects
+  // each group, and fwrite then reports exactly the bytes that reached the
+  // file (a buffered FILE may drop a failed flush's bytes unreported)
+  static FILE *openAppend(const string &path) {
+    FILE *f = fopen(path.c_str(), "ab");
+    if (f != nullptr)
+      setvbuf(f, nullptr, _IONBF, 0);
+    return f;
+  }
+
+  // Creates (or empties) the log file with only its header
+  static bool writeEmpty(const string &path) {
+    WalFileHeader header;
+    memcpy(header.magic, WAL_MAGIC, sizeof(header.magic));
+    header.version = WAL_VERSION;
+    header.reserved = 0;
+    FILE *f = fopen(path.c_str(), "wb");
+    if (f == nullptr)
+      return false;
+    bool ok = fwrite(&header, sizeof(header), 1, f) == 1;
+    ok = (fclose(f) == 0) && ok;
+    return ok && syncFile(path);
+  }
+
+  static uint32_t readU32(const char *&p) {
+    uint32_t value;
+    memcpy(&value, p, 4);
+    p += 4;
+    return value;
+  }
+
+  // Reads one (length, bytes) string; false if it runs past 'end'
+  static bool readString(const char *&p, const char *end, string &out) {
+    if (end - p < 4)
+      return false;
+    uint32_t length = readU32(p);
+    if ((size_t)(end - p) < length)
+      return false;
+    out.assign(p, length);
+    p += length;
+    return true;
+  }
+
+public:
+  WriteAheadLog()
+      : file(nullptr), pendingOps(0), commitEvery(1), commitMs(0), syncs(0),
+        unsynced(false), syncFailed(false), stopping(false) {}
+  WriteAheadLog(const WriteAheadLog &) = delete;
+  WriteAheadLog &operator=(const WriteAheadLog &) = delete;
+  ~WriteAheadLog() { close(); }
+
+  // Opens the log for appending (creating it if needed)
+  // Call replay() first: open() assumes every record in the file is whole
+  // Returns false if the file cannot be opened
+  bool open(const string &logPath, size_t groupSize, int groupMs) {
+    close();
+    path = logPath;
+    commitEvery = (groupSize < 1) ? 1 : groupSize;
+    commitMs = groupMs;
+    syncs = 0;
+    unsynced = false;
+    syncFailed = false;
+    MappedFile existing;
+    if (!existing.open(path) || existing.size() < sizeof(WalFileHeader)) {
+      if (!writeEmpty(path))
+        return false;
+    }
+    file = openAppend(path);
+    lastSync = chrono::steady_clock::now();
+    if (file != nullptr && commitMs > 0) {
+      stopping = false;
+      flusher = thread([this]() { flushLoop(); });
+    }
+    return file != nullptr;
+  }
+
+  // Note: Only the owner's thread opens and closes the log, so this needs
+  // no lock (the flusher never changes 'file')
+  bool isOpen() const { return file != nullptr; }
+
+  // The log calls below return false while the log is failing to sync
+  // (the change stays queued; see syncLocked)
+
+  // Logs a successful addMedicine
+  // commit = false only queues it (e.g., for one sync after a bulk load)
+  bool logAdd(const Medicine &med, bool commit = true) {
+    lock_guard<mutex> guard(lock);
+    size_t start = pending.size();
+    pending.resize(start + sizeof(WalRecordHeader));
+    putU32((uint32_t)med.quantity);
+    putString(med.batchID);
+    putString(med.medicineName);
+    putString(med.expiryDate);
+    putString(med.location);
+    finishRecord(start, WAL_ADD, commit);
+    return !syncFailed;
+  }
+
+  // Logs a successful removeMedicine
+  bool logRemove(string_view batchID) {
+    lock_guard<mutex> guard(lock);
+    size_t start = pending.size();
+    pending.resize(start + sizeof(WalRecordHeader));
+    putString(batchID);
+    finishRecord(start, WAL_REMOVE, true);
+    return !syncFailed;
+  }
+
+  // Logs a successful updateQuantity (one record, so a crash keeps either
+  // the old or the new quantity, never a removed batch)
+  bool logUpdate(string_view batchID, int quantity) {
+    lock_guard<mutex> guard(lock);
+    size_t start = pending.size();
+    pending.resize(start + sizeof(WalRecordHeader));
+    putU32((uint32_t)quantity);
+    putString(batchID);
+    finishRecord(start, WAL_UPDATE, true);
+    return !syncFailed;
+  }
+
+  // Writes the waiting group and fsyncs it; returns false on an I/O error
+  bool sync() {
+    lock_guard<mutex> guard(lock);
+    return syncLocked();
+  }
+
+  // Empties the log (after its changes were saved in a snapshot)
+  bool reset() {
+    lock_guard<mutex> guard(lock);
+    if (file == nullptr)
+      return false;
+    pending.clear();
+    pendingOps = 0;
+    unsynced = false;
+    syncFailed = false;
+    fclose(file);
+    file = nullptr;
+    if (!writeEmpty(path))
+      return false;
+    file = openAppend(path);
+    return file != nullptr;
+  }
+
+  // Stops the flusher, syncs what is waiting and closes the file
+  // Returns false if that last sync failed
+  bool close() {
+    if (flusher.joinable()) {
+      {
+        lock_guard<mutex> guard(lock);
+        stopping = true;
+      }
+      wake.notify_one();
+      flusher.join();
+    }
+    lock_guard<mutex> guard(lock);
+    if (file == nullptr)
+      return true;
+    bool ok = syncLocked(); // Last try: what still fails here is dropped
+    ok = (fclose(file) == 0) && ok;
+    file = nullptr;
+    pending.clear();
+    pendingOps = 0;
+    return ok;
+  }
+
+  size_t syncCount() const {
+    lock_guard<mutex> guard(lock);
+    return syncs;
+  }
+
+  // Re-applies every whole record of a log file, in order:
+  //   onAdd(Medicine &&), onRemove(const string &batchID) and
+  //   onUpdate(const string &batchID, int quantity)
+  // A torn or corrupted tail is cut off the file, so new records follow
+  // the last good one (a version 1 file is rewritten as version 2)
+  // Returns the number of records applied, or -1 if the file is not a log
+  // (a missing file counts as an empty log)
+  template <class OnAdd, class OnRemove, class OnUpdate>
+  static long long replay(const string &logPath, OnAdd onAdd,
+                          OnRemove onRemove, OnUpdate onUpdate) {
+    MappedFile log;
+    if (!log.open(logPath))
+      return 0;
+    WalFileHeader fileHeader;
+    if (log.size() < sizeof(fileHeader))
+      return writeEmpty(logPath) ? 0 : -1; // Crashed while being created
+    memcpy(&fileHeader, log.data(), sizeof(fileHeader));
+    if (memcmp(fileHeader.magic, WAL_MAGIC, sizeof(WAL_MAGIC)) != 0 ||
+        fileHeader.version < 1 || fileHeader.version > WAL_VERSION)
+      return -1;
+
+    const char *p = log.data() + sizeof(fileHeader);
+    const char *end = log.data() + log.size();
+    long long applied = 0;
+    while ((size_t)(end - p) >= sizeof(WalRecordHeader)) {
+      WalRecordHeader header;
+      memcpy(&header, p, sizeof(header));
+      const char *payload = p + sizeof(header);
+      if ((size_t)(end - payload) < header.length ||
+          snapshotChecksum(payload, header.length, header.operation) !=
+              header.checksum)
+        break; // Torn or corrupted: nothing after this can be trusted
+      const char *q = payload;
+      const char *recordEnd = payload + header.length;
+      if (header.operation == WAL_ADD && header.length >= 4) {
+        Medicine med;
+        med.quantity = (int)readU32(q);
+        if (!readString(q, recordEnd, med.batchID) ||
+            !readString(q, recordEnd, med.medicineName) ||
+            !readString(q, recordEnd, med.expiryDate) ||
+            !readString(q, recordEnd, med.location))
+          break;
+        onAdd(std::move(med));
+      } else if (header.operation == WAL_REMOVE) {
+        string batchID;
+        if (!readString(q, recordEnd, batchID))
+          break;
+        onRemove(batchID);
+      } else if (header.operation == WAL_UPDATE && header.length >= 4) {
+        int quantity = (int)readU32(q);
+        string batchID;
+        if (!readString(q, recordEnd, batchID))
+          break;
+        onUpdate(batchID, quantity);
+      } else {
+        break;
+      }
+      applied++;
+      p = recordEnd;
+    }
+
+    if (p != end || fileHeader.version != WAL_VERSION) {
+      // Keep only the good records: rewrite them next to the log and
+      // rename the copy over it (same steps as a snapshot)
+      string temp = logPath + ".tmp";
+      FILE *f = fopen(temp.c_str(), "wb");
+      if (f == nullptr)
+        return -1;
+      fileHeader.version = WAL_VERSION;
+      size_t good = p - (log.data() + sizeof(fileHeader));
+      bool ok = fwrite(&fileHeader, sizeof(fileHeader), 1, f) == 1;
+      ok = fwrite(log.data() + sizeof(fileHeader), 1, good, f) == good && ok;
+      ok = (fclose(f) == 0) && ok;
+      log.close();
+      if (!ok || !syncFile(temp) || rename(temp.c_str(), logPath.c_str()))
+        return -1;
+    }
+    return applied;
+  }
+};
+
+#endif